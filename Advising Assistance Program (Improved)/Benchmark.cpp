@@ -1,18 +1,27 @@
 #include "Benchmark.h"
 #include "FileLoader.h"
+#include "CatalogSnapshot.h"
+#include "InternedCatalog.h"
+#include "CatalogStore.h"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <fstream>
 #include <functional>
 #include <iostream>
+#include <limits>
 #include <random>
 #include <sstream>
+#include <string_view>
+#include <thread>
 #include <unordered_set>
 #include <vector>
 using namespace std;
 
-// Measure time to collect and sort all keys exposed via a callback that visits Courses.
+// Measure time to collect and sort all keys exposed via a callback that visits
+// Courses (or CourseViews).
 template <typename ForEachFn>
 static long long MeasureSortAllKeysMs(ForEachFn forEachFn) {
     using clk = chrono::high_resolution_clock;
@@ -20,236 +29,796 @@ static long long MeasureSortAllKeysMs(ForEachFn forEachFn) {
     keys.reserve(1024);
 
     auto startTime = clk::now();
-    forEachFn([&](const Course& c) { keys.push_back(c.number); });
+    forEachFn([&](const auto& c) { keys.emplace_back(c.number); });
     sort(keys.begin(), keys.end());
     auto endTime = clk::now();
     return chrono::duration_cast<chrono::milliseconds>(endTime - startTime).count();
 }
 
-// Count how many courses start with a given prefix using a callback walker.
+// Count how many courses start with a given prefix (case-insensitive) using a
+// callback walker that visits every course. Repeated RANGE_QUERY_REPEATS times.
 template <typename ForEachFn>
 static pair<long long, size_t> MeasurePrefixCountMs(ForEachFn forEachFn, const string& prefix) {
     using clk = chrono::high_resolution_clock;
     auto startTime = clk::now();
     size_t count = 0;
-    forEachFn([&](const Course& c) {
-        if (c.number.rfind(prefix, 0) == 0) ++count;
-        });
+    for (size_t rep = 0; rep < RANGE_QUERY_REPEATS; ++rep) {
+        count = 0;
+        forEachFn([&](const auto& c) {
+            if (c.number.size() >= prefix.size()
+                && CourseKeyEquals(string_view(c.number).substr(0, prefix.size()), prefix)) {
+                ++count;
+            }
+            });
+    }
     auto endTime = clk::now();
     return { chrono::duration_cast<chrono::milliseconds>(endTime - startTime).count(), count };
 }
 
-// Utility: load only the first CSV field (course number) from the file.
-vector<string> LoadCourseNumbersOnly(const string& filePath) {
-    vector<string> out;
-    ifstream file(filePath);
-    string line;
-    while (getline(file, line)) {
-        if (line.empty()) continue;
-        istringstream ss(line);
-        string number;
-        if (getline(ss, number, ',')) {
-            if (!number.empty()) out.push_back(number);
+// Same measurement through an ordered index's PrefixQuery, which seeks to the
+// first match and stops after the last one.
+template <typename Index>
+static pair<long long, size_t> MeasurePrefixQueryMs(const Index& index, const string& prefix) {
+    using clk = chrono::high_resolution_clock;
+    auto startTime = clk::now();
+    size_t count = 0;
+    for (size_t rep = 0; rep < RANGE_QUERY_REPEATS; ++rep) {
+        count = index.PrefixQuery(prefix, [](const auto&) {});
+    }
+    auto endTime = clk::now();
+    return { chrono::duration_cast<chrono::milliseconds>(endTime - startTime).count(), count };
+}
+
+// Course numbers of the batch in file order, at most `limit` of them.
+static vector<string> CourseNumbers(const CourseBatch& batch, size_t limit = SIZE_MAX) {
+    vector<string> numbers;
+    numbers.reserve(min(limit, batch.records.size()));
+    for (size_t i = 0; i < batch.records.size() && numbers.size() < limit; ++i) {
+        numbers.push_back(batch.records[i].number);
+    }
+    return numbers;
+}
+
+// Build one index from the parsed batch; returns its insert time in ms.
+template <typename Index>
+static long long MeasureIngestMs(Index& index, const CourseBatch& batch) {
+    IngestPipeline pipeline;
+    pipeline.AddSink(index);
+    return pipeline.FanOut(batch).front().insertMs;
+}
+
+// Build hit keys from the dataset (capped at searchTrials) and synthetic misses.
+static void PrepareKeyPools(const CourseBatch& batch, size_t searchTrials,
+    vector<string>& hitKeys, vector<string>& missKeys) {
+    hitKeys = CourseNumbers(batch, searchTrials);
+    missKeys.clear();
+    missKeys.reserve(hitKeys.size());
+    for (size_t i = 0; i < hitKeys.size(); ++i) {
+        missKeys.push_back(hitKeys[i] + "_MISS"); // guaranteed miss without altering the index
+    }
+}
+
+// Time the hit, miss and mixed lookup loops against any index exposing Find().
+// Seeds are per structure so each benchmark keeps its own reproducible key sequence.
+template <typename Index>
+static void MeasureSearchPhases(const Index& index,
+    const vector<string>& hitKeys,
+    const vector<string>& missKeys,
+    size_t searchTrials,
+    double mixedHitRatio,
+    unsigned int hitSeed, unsigned int missSeed, unsigned int mixedSeed,
+    BenchResult& result) {
+    size_t hitPoolSize = hitKeys.empty() ? 1 : hitKeys.size();
+    size_t missPoolSize = missKeys.empty() ? 1 : missKeys.size();
+
+    // Time repeated successful lookups
+    {
+        mt19937 rngHit(hitSeed);
+        uniform_int_distribution<size_t> hitIndexDist(0, hitPoolSize - 1);
+
+        auto loopStart = chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < searchTrials; ++i) {
+            const string& key = hitKeys[hitIndexDist(rngHit)];
+            bool volatile sink = static_cast<bool>(index.Find(key)); // volatile prevents optimization away
+            (void)sink;
         }
+        auto loopEnd = chrono::high_resolution_clock::now();
+        result.searchHitMs = chrono::duration_cast<chrono::milliseconds>(loopEnd - loopStart).count();
     }
-    return out;
+
+    // Time repeated unsuccessful lookups
+    {
+        mt19937 rngMiss(missSeed);
+        uniform_int_distribution<size_t> missIndexDist(0, missPoolSize - 1);
+
+        auto loopStart = chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < searchTrials; ++i) {
+            const string& key = missKeys[missIndexDist(rngMiss)];
+            bool volatile sink = static_cast<bool>(index.Find(key));
+            (void)sink;
+        }
+        auto loopEnd = chrono::high_resolution_clock::now();
+        result.searchMissMs = chrono::duration_cast<chrono::milliseconds>(loopEnd - loopStart).count();
+    }
+
+    // Mixed loop (hits and misses by ratio)
+    {
+        mt19937 rngMixed(mixedSeed);
+        uniform_real_distribution<double> coinFlip(0.0, 1.0);
+        uniform_int_distribution<size_t> hitIndexDist(0, hitPoolSize - 1);
+        uniform_int_distribution<size_t> missIndexDist(0, missPoolSize - 1);
+
+        auto loopStart = chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < searchTrials; ++i) {
+            if (coinFlip(rngMixed) < mixedHitRatio) {
+                const string& key = hitKeys[hitIndexDist(rngMixed)];
+                bool volatile sink = static_cast<bool>(index.Find(key));
+                (void)sink;
+            }
+            else {
+                const string& key = missKeys[missIndexDist(rngMixed)];
+                bool volatile sink = static_cast<bool>(index.Find(key));
+                (void)sink;
+            }
+        }
+        auto loopEnd = chrono::high_resolution_clock::now();
+        result.mixedMs = chrono::duration_cast<chrono::milliseconds>(loopEnd - loopStart).count();
+    }
+}
+
+// Time the same number of hit lookups as the hit phase, issued through
+// SearchMany in transcript-sized batches instead of one Find at a time.
+template <typename Index>
+static long long MeasureBatchSearchMs(const Index& index,
+    const vector<string>& hitKeys,
+    size_t searchTrials,
+    unsigned int seed) {
+    constexpr size_t batchSize = 32; // roughly a transcript plus prerequisites
+    if (hitKeys.empty()) return 0;
+
+    mt19937 rng(seed);
+    uniform_int_distribution<size_t> hitIndexDist(0, hitKeys.size() - 1);
+    vector<string_view> batch;
+    vector<decltype(index.Find(string_view()))> found; // pointers or views, per index
+    batch.reserve(batchSize);
+
+    auto loopStart = chrono::high_resolution_clock::now();
+    size_t done = 0;
+    while (done < searchTrials) {
+        size_t n = min(batchSize, searchTrials - done);
+        batch.clear();
+        for (size_t i = 0; i < n; ++i) batch.push_back(hitKeys[hitIndexDist(rng)]);
+        index.SearchMany(batch, found);
+        bool volatile sink = static_cast<bool>(found.back()); // volatile prevents optimization away
+        (void)sink;
+        done += n;
+    }
+    auto loopEnd = chrono::high_resolution_clock::now();
+    return chrono::duration_cast<chrono::milliseconds>(loopEnd - loopStart).count();
+}
+
+// Time `ops` erase+re-insert pairs applied as term updates of CHURN_BATCH
+// courses each. The batches are drawn from the stored courses up front, so
+// only the index updates are timed and the index size stays constant.
+template <typename ApplyFn>
+static long long MeasureChurnMs(ApplyFn applyChanges,
+    const vector<Course>& stored,
+    size_t ops,
+    unsigned int seed) {
+    if (stored.empty() || ops == 0) return 0;
+
+    mt19937 rng(seed);
+    uniform_int_distribution<size_t> pick(0, stored.size() - 1);
+    vector<vector<Course>> adds;
+    vector<vector<string>> removes;
+    for (size_t done = 0; done < ops; done += CHURN_BATCH) {
+        size_t n = min(CHURN_BATCH, ops - done);
+        adds.emplace_back();
+        removes.emplace_back();
+        for (size_t i = 0; i < n; ++i) {
+            const Course& c = stored[pick(rng)];
+            adds.back().push_back(c);
+            removes.back().push_back(c.number);
+        }
+    }
+
+    auto loopStart = chrono::high_resolution_clock::now();
+    for (size_t b = 0; b < adds.size(); ++b) applyChanges(adds[b], removes[b]);
+    auto loopEnd = chrono::high_resolution_clock::now();
+    return chrono::duration_cast<chrono::milliseconds>(loopEnd - loopStart).count();
 }
 
 // --- HashTable benchmark ------------------------------------------------------
-BenchResult RunHashTableBenchmark(const string& filePath,
+BenchResult RunHashTableBenchmark(const CourseBatch& batch,
     size_t searchTrials,
     double mixedHitRatio,
     const string& rangePrefix) {
     BenchResult result{};
-    result.datasetName = filePath;
+    result.datasetName = batch.sourceName;
+    result.parseMs = batch.parseMs;
 
-    // Build HashTable by streaming the file with FileLoader.
+    // Build HashTable from the parsed batch.
     {
         HashTable hashTable(10007); // initial capacity
-        auto startTime = chrono::high_resolution_clock::now();
-        loadCourses(hashTable, filePath);
-        auto endTime = chrono::high_resolution_clock::now();
-        result.buildMs = chrono::duration_cast<chrono::milliseconds>(endTime - startTime).count();
+        result.buildMs = MeasureIngestMs(hashTable, batch);
 
         // Determine dataset size via iteration; avoids exposing internals.
         size_t courseCount = 0;
-        hashTable.ForEach([&](const Course&) { ++courseCount; });
+        hashTable.ForEach([&](const CourseView&) { ++courseCount; });
         result.numCourses = courseCount;
 
         // Prepare search key pools (hits from dataset; misses synthetic).
-        vector<string> hitKeys = LoadCourseNumbersOnly(filePath);
-        if (!hitKeys.empty() && hitKeys.size() > searchTrials) {
-            hitKeys.resize(searchTrials);
-        }
-        vector<string> missKeys;
-        missKeys.reserve(hitKeys.size());
-        for (size_t i = 0; i < hitKeys.size(); ++i) {
-            missKeys.push_back(hitKeys[i] + "_MISS"); // guaranteed miss without altering the table
-        }
-
+        vector<string> hitKeys, missKeys;
+        PrepareKeyPools(batch, searchTrials, hitKeys, missKeys);
         result.numSearchTrials = searchTrials;
 
-        // Time repeated successful lookups
-        {
-            size_t poolSize = hitKeys.empty() ? 1 : hitKeys.size();
-            mt19937 rngHit(12345);
-            uniform_int_distribution<size_t> hitIndexDist(0, poolSize - 1);
+        MeasureSearchPhases(hashTable, hitKeys, missKeys, searchTrials, mixedHitRatio,
+            12345, 67890, 13579, result);
+        result.batchMs = MeasureBatchSearchMs(hashTable, hitKeys, searchTrials, 12345);
 
-            auto loopStart = chrono::high_resolution_clock::now();
-            for (size_t i = 0; i < searchTrials; ++i) {
-                const string& key = hitKeys[hitIndexDist(rngHit)];
-                volatile Course sink = hashTable.Search(key); // volatile prevents optimization away
-                (void)sink;
-            }
-            auto loopEnd = chrono::high_resolution_clock::now();
-            result.searchHitMs = chrono::duration_cast<chrono::milliseconds>(loopEnd - loopStart).count();
-        }
-
-        // Time repeated unsuccessful lookups
-        {
-            size_t poolSize = missKeys.empty() ? 1 : missKeys.size();
-            mt19937 rngMiss(67890);
-            uniform_int_distribution<size_t> missIndexDist(0, poolSize - 1);
-
-            auto loopStart = chrono::high_resolution_clock::now();
-            for (size_t i = 0; i < searchTrials; ++i) {
-                const string& key = missKeys[missIndexDist(rngMiss)];
-                volatile Course sink = hashTable.Search(key);
-                (void)sink;
-            }
-            auto loopEnd = chrono::high_resolution_clock::now();
-            result.searchMissMs = chrono::duration_cast<chrono::milliseconds>(loopEnd - loopStart).count();
-        }
-
-        // Mixed loop (hits and misses by ratio)
-        {
-            size_t hitPoolSize = hitKeys.empty() ? 1 : hitKeys.size();
-            size_t missPoolSize = missKeys.empty() ? 1 : missKeys.size();
-
-            mt19937 rngMixed(13579);
-            uniform_real_distribution<double> coinFlip(0.0, 1.0);
-            uniform_int_distribution<size_t> hitIndexDist(0, hitPoolSize - 1);
-            uniform_int_distribution<size_t> missIndexDist(0, missPoolSize - 1);
-
-            auto loopStart = chrono::high_resolution_clock::now();
-            for (size_t i = 0; i < searchTrials; ++i) {
-                if (coinFlip(rngMixed) < mixedHitRatio) {
-                    const string& key = hitKeys[hitIndexDist(rngMixed)];
-                    volatile Course sink = hashTable.Search(key);
-                    (void)sink;
-                }
-                else {
-                    const string& key = missKeys[missIndexDist(rngMixed)];
-                    volatile Course sink = hashTable.Search(key);
-                    (void)sink;
-                }
-            }
-            auto loopEnd = chrono::high_resolution_clock::now();
-            result.mixedMs = chrono::duration_cast<chrono::milliseconds>(loopEnd - loopStart).count();
-        }
+        // Churn: HashTable has no batch entry point, so erase then upsert
+        vector<Course> stored;
+        hashTable.ForEach([&](const CourseView& c) { stored.push_back(c.ToCourse()); });
+        result.churnMs = MeasureChurnMs([&](const vector<Course>& adds, const vector<string>& removes) {
+            for (const string& key : removes) hashTable.Erase(key);
+            for (const Course& c : adds) hashTable.Insert(c);
+            }, stored, searchTrials, 12345);
 
         // Prefix count and key collection timings
-        result.rangeMs = MeasurePrefixCountMs([&](auto&& fn) { hashTable.ForEach(fn); }, rangePrefix).first;
+        auto range = MeasurePrefixCountMs([&](auto&& fn) { hashTable.ForEach(fn); }, rangePrefix);
+        result.rangeMs = range.first;
+        result.rangeMatches = range.second;
     }
 
     return result;
 }
 
 // --- RedBlackTree benchmark ---------------------------------------------------
-BenchResult RunRBTBenchmark(const string& filePath,
+BenchResult RunRBTBenchmark(const CourseBatch& batch,
     size_t searchTrials,
     double mixedHitRatio,
     const string& rangePrefix) {
     BenchResult result{};
-    result.datasetName = filePath;
+    result.datasetName = batch.sourceName;
+    result.parseMs = batch.parseMs;
 
     {
         RedBlackTree rbt;
 
-        // Build time: stream file and insert Courses
-        auto startTime = chrono::high_resolution_clock::now();
-        loadCourses(rbt, filePath);
-        auto endTime = chrono::high_resolution_clock::now();
-        result.buildMs = chrono::duration_cast<chrono::milliseconds>(endTime - startTime).count();
+        // Build time: bulk-build the empty tree from the batch
+        result.buildMs = MeasureIngestMs(rbt, batch);
 
         // Determine dataset size by traversal
         result.numCourses = rbt.Size();
 
         // Prepare search key pools
-        vector<string> hitKeys = LoadCourseNumbersOnly(filePath);
-        if (!hitKeys.empty() && hitKeys.size() > searchTrials) {
-            hitKeys.resize(searchTrials);
-        }
-        vector<string> missKeys;
-        missKeys.reserve(hitKeys.size());
-        for (size_t i = 0; i < hitKeys.size(); ++i) {
-            missKeys.push_back(hitKeys[i] + "_MISS");
-        }
+        vector<string> hitKeys, missKeys;
+        PrepareKeyPools(batch, searchTrials, hitKeys, missKeys);
+        result.numSearchTrials = searchTrials;
+
+        MeasureSearchPhases(rbt, hitKeys, missKeys, searchTrials, mixedHitRatio,
+            24680, 97531, 11223, result);
+        result.batchMs = MeasureBatchSearchMs(rbt, hitKeys, searchTrials, 24680);
+
+        // Churn through ApplyChanges: only the affected nodes are touched
+        vector<Course> stored;
+        stored.reserve(rbt.Size());
+        rbt.ForEach([&](const CourseView& c) { stored.push_back(c.ToCourse()); });
+        result.churnMs = MeasureChurnMs([&](const vector<Course>& adds, const vector<string>& removes) {
+            rbt.ApplyChanges(adds, removes);
+            }, stored, searchTrials, 24680);
 
+        // Prefix count and key collection timings
+        // Prefix query seeks and stops instead of scanning every course
+        auto range = MeasurePrefixQueryMs(rbt, rangePrefix);
+        result.rangeMs = range.first;
+        result.rangeMatches = range.second;
+    }
+
+    // Insert-one-at-a-time vs. bulk build over the same parsed records,
+    // so parsing cost is excluded from both
+    {
+        using clk = chrono::high_resolution_clock;
+        RedBlackTree incremental;
+        auto startTime = clk::now();
+        for (const Course& c : batch.records) incremental.Insert(c);
+        auto endTime = clk::now();
+        result.insertBuildMs = chrono::duration_cast<chrono::milliseconds>(endTime - startTime).count();
+
+        RedBlackTree bulk;
+        vector<Course> input = batch.records; // copied outside the timed region
+        startTime = clk::now();
+        bulk.BuildFromSorted(std::move(input));
+        endTime = clk::now();
+        result.bulkBuildMs = chrono::duration_cast<chrono::milliseconds>(endTime - startTime).count();
+    }
+
+    return result;
+}
+
+// --- FrozenCatalog benchmark --------------------------------------------------
+BenchResult RunFrozenCatalogBenchmark(const CourseBatch& batch,
+    size_t searchTrials,
+    double mixedHitRatio,
+    const string& rangePrefix) {
+    BenchResult result{};
+    result.datasetName = batch.sourceName;
+    result.parseMs = batch.parseMs;
+
+    {
+        FrozenCatalog catalog;
+
+        // Build time: construct the perfect hash once over the batch
+        result.buildMs = MeasureIngestMs(catalog, batch);
+
+        result.numCourses = catalog.Size();
+
+        vector<string> hitKeys, missKeys;
+        PrepareKeyPools(batch, searchTrials, hitKeys, missKeys);
         result.numSearchTrials = searchTrials;
 
-        // Successful lookups
-        {
-            size_t poolSize = hitKeys.empty() ? 1 : hitKeys.size();
-            mt19937 rngHit(24680);
-            uniform_int_distribution<size_t> hitIndexDist(0, poolSize - 1);
+        MeasureSearchPhases(catalog, hitKeys, missKeys, searchTrials, mixedHitRatio,
+            31415, 92653, 58979, result);
 
-            auto loopStart = chrono::high_resolution_clock::now();
-            for (size_t i = 0; i < searchTrials; ++i) {
-                const string& key = hitKeys[hitIndexDist(rngHit)];
-                volatile Course sink = rbt.Search(key);
-                (void)sink;
-            }
-            auto loopEnd = chrono::high_resolution_clock::now();
-            result.searchHitMs = chrono::duration_cast<chrono::milliseconds>(loopEnd - loopStart).count();
+        // No key order to exploit; prefix counting is a full scan as for the HashTable
+        auto range = MeasurePrefixCountMs([&](auto&& fn) { catalog.ForEach(fn); }, rangePrefix);
+        result.rangeMs = range.first;
+        result.rangeMatches = range.second;
+    }
+
+    return result;
+}
+
+// --- StaticIndex benchmark ---------------------------------------------------
+BenchResult RunStaticIndexBenchmark(const CourseBatch& batch,
+    size_t searchTrials,
+    double mixedHitRatio,
+    const string& rangePrefix) {
+    BenchResult result{};
+    result.datasetName = batch.sourceName;
+    result.parseMs = batch.parseMs;
+
+    {
+        StaticIndex index;
+
+        // Build time: sort the batch, then lay it out in Eytzinger order
+        result.buildMs = MeasureIngestMs(index, batch);
+
+        result.numCourses = index.Size();
+
+        vector<string> hitKeys, missKeys;
+        PrepareKeyPools(batch, searchTrials, hitKeys, missKeys);
+        result.numSearchTrials = searchTrials;
+
+        MeasureSearchPhases(index, hitKeys, missKeys, searchTrials, mixedHitRatio,
+            27182, 81828, 45904, result);
+
+        auto range = MeasurePrefixQueryMs(index, rangePrefix);
+        result.rangeMs = range.first;
+        result.rangeMatches = range.second;
+    }
+
+    return result;
+}
+
+// --- CourseTrie benchmark ----------------------------------------------------
+BenchResult RunTrieBenchmark(const CourseBatch& batch,
+    size_t searchTrials,
+    double mixedHitRatio,
+    const string& rangePrefix) {
+    BenchResult result{};
+    result.datasetName = batch.sourceName;
+    result.parseMs = batch.parseMs;
+
+    {
+        CourseTrie trie;
+
+        result.buildMs = MeasureIngestMs(trie, batch);
+
+        result.numCourses = trie.Size();
+        result.structureBytes = trie.StructureBytes();
+
+        vector<string> hitKeys, missKeys;
+        PrepareKeyPools(batch, searchTrials, hitKeys, missKeys);
+        result.numSearchTrials = searchTrials;
+
+        MeasureSearchPhases(trie, hitKeys, missKeys, searchTrials, mixedHitRatio,
+            16180, 33988, 74989, result);
+
+        // Prefix query walks the prefix, then only the matching subtree
+        auto range = MeasurePrefixQueryMs(trie, rangePrefix);
+        result.rangeMs = range.first;
+        result.rangeMatches = range.second;
+    }
+
+    return result;
+}
+
+// --- Memory footprint ---------------------------------------------------------
+// Heap bytes owned by a string: none while it fits the small-string buffer
+// inside the object itself.
+static size_t StringHeapBytes(const string& s) {
+    const char* inside = reinterpret_cast<const char*>(&s);
+    bool small = s.data() >= inside && s.data() < inside + sizeof(string);
+    return small ? 0 : s.capacity() + 1;
+}
+
+MemoryFootprintResult RunMemoryFootprintBenchmark(const CourseBatch& batch) {
+    MemoryFootprintResult result;
+    result.datasetName = batch.sourceName;
+
+    InternedCatalog interned;
+    interned.Build(batch.records);
+    result.courses = interned.Size();
+    result.internedStrings = interned.Numbers().Size();
+    result.internedBytes = interned.MemoryBytes();
+
+    // The same distinct courses as Course values, as an index used to hold them
+    CatalogStore store;
+    vector<size_t> lastRecord(result.internedStrings, SIZE_MAX);
+    for (size_t i = 0; i < batch.records.size(); ++i) {
+        lastRecord[interned.Numbers().Find(batch.records[i].number)] = i;
+    }
+    for (size_t record : lastRecord) {
+        if (record == SIZE_MAX) continue; // only ever a prerequisite
+        Course course = batch.records[record]; // copy: capacity as stored, not as parsed
+        result.courseBytes += sizeof(Course) + StringHeapBytes(course.number) + StringHeapBytes(course.title)
+            + course.prerequisites.capacity() * sizeof(string);
+        for (const string& p : course.prerequisites) result.courseBytes += StringHeapBytes(p);
+        result.prerequisiteRefs += course.prerequisites.size();
+        store.Add(course);
+    }
+    result.storeBytes = store.MemoryBytes();
+
+    // The store-backed indexes, built the way the loader builds them
+    HashTable hashTable(10007);
+    for (const Course& course : batch.records) hashTable.Insert(course);
+    result.hashTableBytes = hashTable.MemoryBytes();
+    RedBlackTree tree;
+    tree.BuildFromSorted(batch.records);
+    result.treeBytes = tree.MemoryBytes();
+
+    if (result.courses > 0) {
+        double courses = static_cast<double>(result.courses);
+        result.courseBytesPerCourse = result.courseBytes / courses;
+        result.storeBytesPerCourse = result.storeBytes / courses;
+        result.hashTableBytesPerCourse = result.hashTableBytes / courses;
+        result.treeBytesPerCourse = result.treeBytes / courses;
+        result.internedBytesPerCourse = result.internedBytes / courses;
+    }
+    return result;
+}
+
+// --- Department / level ranges ---------------------------------------------------
+// Time RANGE_QUERY_REPEATS runs of a query that reports its match count.
+template <typename QueryFn>
+static pair<long long, size_t> MeasureCountingQueryMs(QueryFn query) {
+    using clk = chrono::high_resolution_clock;
+    auto startTime = clk::now();
+    size_t count = 0;
+    for (size_t rep = 0; rep < RANGE_QUERY_REPEATS; ++rep) count = query();
+    auto endTime = clk::now();
+    return { chrono::duration_cast<chrono::milliseconds>(endTime - startTime).count(), count };
+}
+
+DepartmentRangeResult RunDepartmentRangeBenchmark(const CourseBatch& batch,
+    const string& department, uint32_t level) {
+    DepartmentRangeResult result;
+    result.datasetName = batch.sourceName;
+    result.department = department;
+    result.level = level;
+
+    HashTable hashTable(10007);
+    MeasureIngestMs(hashTable, batch);
+    RedBlackTree tree;
+    MeasureIngestMs(tree, batch);
+
+    // The index is secondary: it groups the tree's record IDs
+    using clk = chrono::high_resolution_clock;
+    DepartmentIndex index;
+    auto buildStart = clk::now();
+    index.Build(tree);
+    result.indexBuildMs = chrono::duration_cast<chrono::milliseconds>(clk::now() - buildStart).count();
+
+    // Every row answers DepartmentIndex's query: the exact department (a
+    // plain "MU" prefix would also match MUS), and for a level, three-digit
+    // numbers whose first digit is level / 100 (PHYS3 also prefixes PHYS3010).
+    uint32_t levelDigit = level / 100;
+    auto matches = [&](string_view number, bool anyLevel) {
+        DepartmentIndex::CourseCode code;
+        return DepartmentIndex::ParseCourseNumber(number, code)
+            && CourseKeyEquals(code.department, department)
+            && (anyLevel || (code.level != DepartmentIndex::NO_LEVEL && code.level / 100 == levelDigit));
+        };
+    auto walkQuery = [&](bool anyLevel) {
+        size_t count = 0;
+        hashTable.ForEach([&](const CourseView& c) { if (matches(c.number, anyLevel)) ++count; });
+        return count;
+        };
+    // The seek narrows to the shortest prefix all matches share, then filters
+    auto seekQuery = [&](const string& prefix, bool anyLevel) {
+        size_t count = 0;
+        tree.PrefixQuery(prefix, [&](const CourseView& c) { if (matches(c.number, anyLevel)) ++count; });
+        return count;
+        };
+    string levelPrefix = levelDigit < DepartmentIndex::LEVELS
+        ? department + static_cast<char>('0' + levelDigit) : department;
+    auto ignore = [](const CourseView&) {};
+
+    auto walk = MeasureCountingQueryMs([&]() { return walkQuery(true); });
+    auto seek = MeasureCountingQueryMs([&]() { return seekQuery(department, true); });
+    auto jump = MeasureCountingQueryMs([&]() { return index.Department(department, ignore); });
+    result.walkDepartmentMs = walk.first;
+    result.walkDepartmentMatches = walk.second;
+    result.seekDepartmentMs = seek.first;
+    result.seekDepartmentMatches = seek.second;
+    result.indexDepartmentMs = jump.first;
+    result.indexDepartmentMatches = jump.second;
+
+    walk = MeasureCountingQueryMs([&]() { return walkQuery(false); });
+    seek = MeasureCountingQueryMs([&]() { return seekQuery(levelPrefix, false); });
+    jump = MeasureCountingQueryMs([&]() { return index.LevelBand(department, level, level, ignore); });
+    result.walkLevelMs = walk.first;
+    result.walkLevelMatches = walk.second;
+    result.seekLevelMs = seek.first;
+    result.seekLevelMatches = seek.second;
+    result.indexLevelMs = jump.first;
+    result.indexLevelMatches = jump.second;
+    return result;
+}
+
+// --- Loader throughput ----------------------------------------------------------
+// The loader as it was before memory mapping: one getline, one istringstream
+// and one std::string per token for every line. Kept as the baseline.
+static size_t ParseWithStreams(const string& filePath, vector<Course>& courses) {
+    ifstream file(filePath);
+    string line;
+    while (getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+
+        istringstream ss(line);
+        string courseNumber, courseName, token;
+        vector<string> prerequisites;
+        if (!getline(ss, courseNumber, ',')) continue;
+        if (!getline(ss, courseName, ',')) continue;
+        if (courseNumber.empty() || courseName.empty()) continue;
+        while (getline(ss, token, ',')) {
+            if (!token.empty()) prerequisites.push_back(token);
         }
+        courses.push_back(Course(courseNumber, courseName, prerequisites));
+    }
+    return courses.size();
+}
 
-        // Unsuccessful lookups
-        {
-            size_t poolSize = missKeys.empty() ? 1 : missKeys.size();
-            mt19937 rngMiss(97531);
-            uniform_int_distribution<size_t> missIndexDist(0, poolSize - 1);
+LoaderThroughputResult RunLoaderThroughputBenchmark(const string& filePath) {
+    LoaderThroughputResult result;
+    result.datasetName = filePath;
+    {
+        ifstream sizeProbe(filePath, ios::binary | ios::ate);
+        if (!sizeProbe) {
+            cout << "Error: Could not open file: " << filePath << endl;
+            return result;
+        }
+        result.bytes = static_cast<size_t>(sizeProbe.tellg());
+    }
 
-            auto loopStart = chrono::high_resolution_clock::now();
-            for (size_t i = 0; i < searchTrials; ++i) {
-                const string& key = missKeys[missIndexDist(rngMiss)];
-                volatile Course sink = rbt.Search(key);
-                (void)sink;
+    using clk = chrono::high_resolution_clock;
+    double megabytes = result.bytes / (1024.0 * 1024.0);
+    result.parserThreads = max(1u, thread::hardware_concurrency());
+
+    // Untimed warm-up: page cache, allocator arenas and the parse threads
+    vector<Course> courses;
+    readCourses(filePath, courses);
+    result.records = courses.size();
+
+    // Variants: 0 = stream baseline, 1 = mapped on one thread, 2 = mapped in parallel
+    double* bestMs[] = { &result.baselineMs, &result.mappedMs, &result.parallelMs };
+    for (double* best : bestMs) *best = numeric_limits<double>::max();
+    for (size_t round = 0; round < LOADER_REPEATS; ++round) {
+        for (size_t step = 0; step < 3; ++step) {
+            size_t variant = (round + step) % 3; // rotate who runs first
+            vector<Course> parsed;
+            auto startTime = clk::now();
+            if (variant == 0) {
+                ParseWithStreams(filePath, parsed);
             }
-            auto loopEnd = chrono::high_resolution_clock::now();
-            result.searchMissMs = chrono::duration_cast<chrono::milliseconds>(loopEnd - loopStart).count();
+            else {
+                setLoaderThreadCount(variant == 1 ? 1 : 0);
+                readCourses(filePath, parsed);
+            }
+            auto endTime = clk::now();
+            double ms = chrono::duration<double, milli>(endTime - startTime).count();
+            *bestMs[variant] = min(*bestMs[variant], ms);
+        }
+    }
+    setLoaderThreadCount(0);
+
+    {
+        // Build from the warm-up parse; no second pass over the file
+        RedBlackTree tree;
+        tree.BuildFromSorted(std::move(courses));
+        string snapshotPath = filePath + CatalogSnapshot::EXTENSION;
+        if (CatalogSnapshot::Write(snapshotPath, tree, filePath)) {
+            CatalogSnapshot snapshot;
+            auto startTime = clk::now();
+            snapshot.Open(snapshotPath);
+            auto endTime = clk::now();
+            result.snapshotOpenMs = chrono::duration<double, milli>(endTime - startTime).count();
+        }
+    }
+
+    if (result.baselineMs > 0.0) result.baselineMBps = megabytes / (result.baselineMs / 1000.0);
+    if (result.mappedMs > 0.0) result.mappedMBps = megabytes / (result.mappedMs / 1000.0);
+    if (result.parallelMs > 0.0) result.parallelMBps = megabytes / (result.parallelMs / 1000.0);
+    return result;
+}
+
+bool GenerateCatalogFile(const string& filePath, size_t rows, unsigned int seed) {
+    static const char* const departments[] = {
+        "ART", "BIO", "CHEM", "CS", "ECON", "ENG", "HIST", "MATH", "MUS", "PHIL", "PHYS", "PSY", "STAT" };
+    static const char* const words[] = {
+        "Introduction", "to", "Advanced", "Topics", "in", "Data", "Structures", "Physics",
+        "Chemistry", "Social", "Development", "Modern", "Theory", "Methods", "Seminar", "II" };
+    constexpr size_t departmentCount = sizeof(departments) / sizeof(departments[0]);
+    constexpr size_t wordCount = sizeof(words) / sizeof(words[0]);
+
+    ofstream out(filePath, ios::binary);
+    if (!out) {
+        cout << "Error: Could not write file: " << filePath << endl;
+        return false;
+    }
+
+    mt19937 rng(seed);
+    auto randomKey = [&]() {
+        // Wide number range so a 1M-row file stays mostly unique keys
+        return string(departments[rng() % departmentCount]) + to_string(100 + rng() % 900000);
+    };
+    string line;
+    for (size_t i = 0; i < rows; ++i) {
+        line = randomKey();
+        line += ',';
+        size_t titleWords = 2 + rng() % 3;
+        for (size_t w = 0; w < titleWords; ++w) {
+            if (w > 0) line += ' ';
+            line += words[rng() % wordCount];
+        }
+        size_t prerequisites = rng() % 4;
+        for (size_t p = 0; p < prerequisites; ++p) {
+            line += ',';
+            line += randomKey();
         }
+        line += '\n';
+        out << line;
+    }
+    return static_cast<bool>(out);
+}
 
-        // Mixed lookups
-        {
-            size_t hitPoolSize = hitKeys.empty() ? 1 : hitKeys.size();
-            size_t missPoolSize = missKeys.empty() ? 1 : missKeys.size();
-
-            mt19937 rngMixed(11223);
-            uniform_real_distribution<double> coinFlip(0.0, 1.0);
-            uniform_int_distribution<size_t> hitIndexDist(0, hitPoolSize - 1);
-            uniform_int_distribution<size_t> missIndexDist(0, missPoolSize - 1);
-
-            auto loopStart = chrono::high_resolution_clock::now();
-            for (size_t i = 0; i < searchTrials; ++i) {
-                if (coinFlip(rngMixed) < mixedHitRatio) {
-                    const string& key = hitKeys[hitIndexDist(rngMixed)];
-                    volatile Course sink = rbt.Search(key);
-                    (void)sink;
+// --- Reader thread scaling -----------------------------------------------------
+// On 1, 2, 4, ... maxThreads reader threads, each thread calls `lookup(i, rng)`
+// with its own lookup index i = 0 .. lookupsPerThread - 1 (the snapshot reader
+// re-pins on it); if withWriter, a writer calls update(i) with i = 0, 1, 2, ...
+// until every reader is done. `lookup` returns true on a hit.
+template <typename LookupFn, typename UpdateFn>
+static vector<ThreadScalingResult> MeasureReaderScaling(size_t maxThreads,
+    size_t lookupsPerThread,
+    bool withWriter,
+    LookupFn lookup,
+    UpdateFn update) {
+    vector<ThreadScalingResult> results;
+    if (maxThreads == 0) maxThreads = 1;
+
+    vector<size_t> threadCounts;
+    for (size_t t = 1; t < maxThreads; t *= 2) threadCounts.push_back(t);
+    threadCounts.push_back(maxThreads);
+
+    for (size_t threads : threadCounts) {
+        atomic<bool> go(false);
+        atomic<size_t> readersDone(0);
+        atomic<size_t> found(0);
+        size_t writerUpdates = 0;
+
+        vector<thread> readers;
+        for (size_t t = 0; t < threads; ++t) {
+            readers.emplace_back([&, t]() {
+                mt19937 rng(static_cast<unsigned int>(1000 + t));
+                while (!go.load(memory_order_acquire)) this_thread::yield();
+
+                size_t localFound = 0;
+                for (size_t i = 0; i < lookupsPerThread; ++i) {
+                    if (lookup(i, rng)) ++localFound;
                 }
-                else {
-                    const string& key = missKeys[missIndexDist(rngMixed)];
-                    volatile Course sink = rbt.Search(key);
-                    (void)sink;
+                found += localFound;
+                ++readersDone;
+                });
+        }
+
+        thread writer;
+        if (withWriter) {
+            writer = thread([&]() {
+                while (!go.load(memory_order_acquire)) this_thread::yield();
+                size_t i = 0;
+                while (readersDone.load() < threads) {
+                    update(i);
+                    ++i;
                 }
-            }
-            auto loopEnd = chrono::high_resolution_clock::now();
-            result.mixedMs = chrono::duration_cast<chrono::milliseconds>(loopEnd - loopStart).count();
+                writerUpdates = i;
+                });
         }
 
-        // Prefix count and key collection timings
-        result.rangeMs = MeasurePrefixCountMs([&](auto&& fn) { rbt.ForEach(fn); }, rangePrefix).first;
+        auto startTime = chrono::high_resolution_clock::now();
+        go.store(true, memory_order_release);
+        for (thread& r : readers) r.join();
+        auto endTime = chrono::high_resolution_clock::now();
+        if (writer.joinable()) writer.join();
+
+        ThreadScalingResult r;
+        r.threads = threads;
+        r.lookups = threads * lookupsPerThread;
+        r.elapsedMs = chrono::duration_cast<chrono::milliseconds>(endTime - startTime).count();
+        double seconds = chrono::duration<double>(endTime - startTime).count();
+        r.lookupsPerSec = seconds > 0.0 ? r.lookups / seconds : 0.0;
+        r.writerUpdates = writerUpdates;
+        results.push_back(r);
     }
 
-    return result;
+    return results;
+}
+
+// --- ConcurrentHashTable thread scaling -----------------------------------------
+vector<ThreadScalingResult> RunConcurrentLookupBenchmark(const string& filePath,
+    size_t maxThreads,
+    size_t lookupsPerThread,
+    bool withWriter) {
+    CourseBatch batch;
+    if (!IngestPipeline::Parse(filePath, batch)) return {};
+    ConcurrentHashTable table;
+    MeasureIngestMs(table, batch);
+
+    vector<string> hitKeys = CourseNumbers(batch);
+    if (hitKeys.empty()) return {};
+
+    // Courses the writer re-upserts; same keys, so reader hit rates are unaffected
+    vector<Course> updates;
+    table.ForEach([&](const CourseView& c) { updates.push_back(c.ToCourse()); });
+
+    return MeasureReaderScaling(maxThreads, lookupsPerThread, withWriter,
+        [&](size_t, mt19937& rng) {
+            return table.Contains(hitKeys[uniform_int_distribution<size_t>(0, hitKeys.size() - 1)(rng)]);
+        },
+        [&](size_t i) { table.Insert(updates[i % updates.size()]); });
+}
+
+// --- PersistentRedBlackTree snapshot readers -----------------------------------
+vector<ThreadScalingResult> RunSnapshotLookupBenchmark(const string& filePath,
+    size_t maxThreads,
+    size_t lookupsPerThread,
+    bool withWriter) {
+    CourseBatch batch;
+    if (!IngestPipeline::Parse(filePath, batch)) return {};
+    PersistentRedBlackTree catalog;
+    {
+        RedBlackTree tree;
+        MeasureIngestMs(tree, batch);
+        catalog.Assign(tree);
+    }
+
+    vector<string> hitKeys = CourseNumbers(batch);
+    if (hitKeys.empty()) return {};
+
+    vector<Course> updates;
+    catalog.Pin().ForEach([&](const Course& c) { updates.push_back(c); });
+
+    // Each reader re-pins every SNAPSHOT_PIN_INTERVAL lookups, as a request
+    // handler would per transcript
+    constexpr size_t SNAPSHOT_PIN_INTERVAL = 32;
+    return MeasureReaderScaling(maxThreads, lookupsPerThread, withWriter,
+        [&](size_t i, mt19937& rng) {
+            thread_local PersistentRedBlackTree::Snapshot snapshot;
+            if (i % SNAPSHOT_PIN_INTERVAL == 0) snapshot = catalog.Pin();
+            bool hit = snapshot.Find(hitKeys[uniform_int_distribution<size_t>(0, hitKeys.size() - 1)(rng)]) != nullptr;
+            if (i + 1 == lookupsPerThread) snapshot = PersistentRedBlackTree::Snapshot();
+            return hit;
+        },
+        [&](size_t i) { catalog.Insert(updates[i % updates.size()]); });
 }
@@ -4,17 +4,35 @@
 #include <chrono>
 #include "HashTable.h"
 #include "RedBlackTree.h"
+#include "FrozenCatalog.h"
+#include "StaticIndex.h"
+#include "CourseTrie.h"
+#include "ConcurrentHashTable.h"
+#include "PersistentRedBlackTree.h"
+#include "IngestPipeline.h"
+#include "DepartmentIndex.h"
 
 /**
  * @file Benchmark.h
  * @brief Data structures and helpers for timing builds and searches over datasets.
  *
- * This module builds the HashTable and RedBlackTree from an input dataset and
+ * This module builds the HashTable, RedBlackTree, FrozenCatalog, StaticIndex and CourseTrie from an input dataset and
  * measures elapsed times for construction and several search scenarios.
+ * The dataset is parsed once into a CourseBatch; every index and key pool
+ * is built from that batch, so parse and build times are reported apart.
  * No exceptions are thrown for missing files; results are returned with
  * zeroed timings if setup fails upstream.
  */
 
+/** Number of times the range/prefix phase repeats its query (ms resolution). */
+constexpr size_t RANGE_QUERY_REPEATS = 1000;
+
+/** Timed rounds per loader variant; each variant reports its fastest round. */
+constexpr size_t LOADER_REPEATS = 3;
+
+/** Courses per term update in the churn phase (each is erased, then re-added). */
+constexpr size_t CHURN_BATCH = 256;
+
 struct BenchResult {
     // Dataset metadata
     std::string datasetName;
@@ -22,39 +40,221 @@ struct BenchResult {
     size_t numSearchTrials = 0;
 
     // Timings (milliseconds)
-    long long buildMs = 0;       // structure build time
+    long long parseMs = 0;       // parsing the dataset into the shared CourseBatch
+    long long buildMs = 0;       // structure build time from the parsed batch (excludes parsing)
     long long searchHitMs = 0;   // repeated successful lookups
     long long searchMissMs = 0;  // repeated unsuccessful lookups
     long long mixedMs = 0;       // mix of hits/misses (ratio controlled by caller)
-    long long rangeMs = 0;       // range/prefix scan timing
+    long long rangeMs = 0;       // range/prefix query timing (RANGE_QUERY_REPEATS runs)
+    size_t rangeMatches = 0;     // courses matching the range/prefix query
+    long long batchMs = 0;       // hit lookups issued through SearchMany (0 if unsupported)
+    long long insertBuildMs = 0; // parsed records inserted one at a time (RBT only)
+    long long bulkBuildMs = 0;   // same records through BuildFromSorted (RBT only)
+    long long churnMs = 0;       // numSearchTrials erase+insert pairs in CHURN_BATCH updates (0 if immutable)
+    size_t structureBytes = 0;   // index structure excluding Course records (0 if not reported)
 };
 
 /**
- * @brief Run HashTable benchmarks over the dataset at filePath.
- * @param filePath      Input dataset path.
+ * @brief Run HashTable benchmarks over a parsed dataset.
+ * @param batch         Dataset parsed once by IngestPipeline::Parse.
  * @param searchTrials  Number of trials for search loops.
  * @param mixedHitRatio Ratio in [0,1] of hits in the mixed search loop (e.g., 0.5).
  * @param rangePrefix   Optional prefix for a range/prefix query (e.g., "CS2").
  */
-BenchResult RunHashTableBenchmark(const std::string& filePath,
+BenchResult RunHashTableBenchmark(const CourseBatch& batch,
+    size_t searchTrials = 5000,
+    double mixedHitRatio = 0.5,
+    const std::string& rangePrefix = "CS");
+
+/**
+ * @brief Run RedBlackTree benchmarks over a parsed dataset.
+ * @param batch         Dataset parsed once by IngestPipeline::Parse.
+ * @param searchTrials  Number of trials for search loops.
+ * @param mixedHitRatio Ratio in [0,1] of hits in the mixed search loop.
+ * @param rangePrefix   Optional prefix for a range/prefix query (e.g., "CS2").
+ */
+BenchResult RunRBTBenchmark(const CourseBatch& batch,
+    size_t searchTrials = 5000,
+    double mixedHitRatio = 0.5,
+    const std::string& rangePrefix = "CS");
+
+/**
+ * @brief Run FrozenCatalog benchmarks over a parsed dataset.
+ *        Build time is constructing the perfect hash.
+ * @param batch         Dataset parsed once by IngestPipeline::Parse.
+ * @param searchTrials  Number of trials for search loops.
+ * @param mixedHitRatio Ratio in [0,1] of hits in the mixed search loop.
+ * @param rangePrefix   Optional prefix for a range/prefix query (e.g., "CS2").
+ */
+BenchResult RunFrozenCatalogBenchmark(const CourseBatch& batch,
+    size_t searchTrials = 5000,
+    double mixedHitRatio = 0.5,
+    const std::string& rangePrefix = "CS");
+
+/**
+ * @brief Run StaticIndex benchmarks over a parsed dataset.
+ *        Build time is sorting the batch and laying it out.
+ * @param batch         Dataset parsed once by IngestPipeline::Parse.
+ * @param searchTrials  Number of trials for search loops.
+ * @param mixedHitRatio Ratio in [0,1] of hits in the mixed search loop.
+ * @param rangePrefix   Optional prefix for a range/prefix query (e.g., "CS2").
+ */
+BenchResult RunStaticIndexBenchmark(const CourseBatch& batch,
     size_t searchTrials = 5000,
     double mixedHitRatio = 0.5,
     const std::string& rangePrefix = "CS");
 
 /**
- * @brief Run RedBlackTree benchmarks over the dataset at filePath.
- * @param filePath      Input dataset path.
+ * @brief Run CourseTrie benchmarks over a parsed dataset.
+ * @param batch         Dataset parsed once by IngestPipeline::Parse.
  * @param searchTrials  Number of trials for search loops.
  * @param mixedHitRatio Ratio in [0,1] of hits in the mixed search loop.
  * @param rangePrefix   Optional prefix for a range/prefix query (e.g., "CS2").
  */
-BenchResult RunRBTBenchmark(const std::string& filePath,
+BenchResult RunTrieBenchmark(const CourseBatch& batch,
     size_t searchTrials = 5000,
     double mixedHitRatio = 0.5,
     const std::string& rangePrefix = "CS");
 
 /**
- * @brief Load only course numbers from a CSV-like dataset file.
- * @return Vector of catalog keys in file order.
+ * @brief Lookup throughput of the ConcurrentHashTable at one thread count.
+ */
+struct ThreadScalingResult {
+    size_t threads = 0;          // reader threads
+    size_t lookups = 0;          // total lookups across all readers
+    long long elapsedMs = 0;     // wall time for all readers
+    double lookupsPerSec = 0.0;  // lookups / elapsed seconds
+    size_t writerUpdates = 0;    // upserts applied by the background writer (0 if none)
+};
+
+/**
+ * @brief Measure ConcurrentHashTable lookup throughput at 1, 2, 4, ... threads
+ *        up to maxThreads (maxThreads itself is always included).
+ * @param filePath          Input dataset path.
+ * @param maxThreads        Largest reader thread count to test.
+ * @param lookupsPerThread  Hit lookups performed by each reader.
+ * @param withWriter        If true, a writer thread keeps upserting courses
+ *                          while the readers run.
+ */
+std::vector<ThreadScalingResult> RunConcurrentLookupBenchmark(const std::string& filePath,
+    size_t maxThreads,
+    size_t lookupsPerThread = 200000,
+    bool withWriter = false);
+
+/**
+ * @brief Measure reader throughput on PersistentRedBlackTree snapshots at
+ *        1, 2, 4, ... threads up to maxThreads. Readers pin a snapshot per
+ *        32 lookups; with a writer, each upsert publishes a new version.
+ * @param filePath          Input dataset path.
+ * @param maxThreads        Largest reader thread count to test.
+ * @param lookupsPerThread  Hit lookups performed by each reader.
+ * @param withWriter        If true, a writer thread keeps upserting courses
+ *                          while the readers run.
+ */
+std::vector<ThreadScalingResult> RunSnapshotLookupBenchmark(const std::string& filePath,
+    size_t maxThreads,
+    size_t lookupsPerThread = 200000,
+    bool withWriter = false);
+
+/**
+ * @brief Parse throughput of the course loader on one file.
+ */
+struct LoaderThroughputResult {
+    std::string datasetName;
+    size_t bytes = 0;          // file size
+    size_t records = 0;        // valid records parsed
+    // Parse times are the best of LOADER_REPEATS rounds after an untimed warm-up
+    double baselineMs = 0.0;   // getline + istringstream per line (the previous loader)
+    double mappedMs = 0.0;     // memory-mapped, in-place tokenizing loader on one thread
+    double parallelMs = 0.0;   // the same loader splitting the file across parserThreads
+    double snapshotOpenMs = 0.0; // map + validate the compiled snapshot (queryable, nothing parsed)
+    double baselineMBps = 0.0;
+    double mappedMBps = 0.0;
+    double parallelMBps = 0.0;
+    size_t parserThreads = 0;
+};
+
+/**
+ * @brief Time parsing `filePath` into Course records with the previous
+ *        stream-based parser, with the memory-mapped loader on one thread,
+ *        and with the loader's default (one per hardware thread) parallelism.
+ *        One untimed pass warms the page cache and allocator first; the
+ *        variants then run in a rotating order for LOADER_REPEATS rounds and
+ *        each keeps its fastest time, so no variant always runs cold.
+ *        Also writes the file's CatalogSnapshot and times opening it.
+ */
+LoaderThroughputResult RunLoaderThroughputBenchmark(const std::string& filePath);
+
+/**
+ * @brief Memory held per course by Course records, a CatalogStore, the two
+ *        store-backed indexes and an InternedCatalog. Byte counts are
+ *        container capacities; allocator overhead is excluded.
+ */
+struct MemoryFootprintResult {
+    std::string datasetName;
+    size_t courses = 0;             // distinct course numbers (duplicates resolved last-wins)
+    size_t prerequisiteRefs = 0;    // prerequisite entries across all courses
+    size_t internedStrings = 0;     // distinct course numbers incl. prerequisite-only ones
+    size_t courseBytes = 0;         // Course objects + heap strings + prerequisite vectors
+    size_t storeBytes = 0;          // CatalogStore arenas and per-record refs
+    size_t hashTableBytes = 0;      // HashTable buckets + its CatalogStore
+    size_t treeBytes = 0;           // RedBlackTree nodes + its CatalogStore
+    size_t internedBytes = 0;       // InternedCatalog arenas, ID spans and interner
+    double courseBytesPerCourse = 0.0;
+    double storeBytesPerCourse = 0.0;
+    double hashTableBytesPerCourse = 0.0;
+    double treeBytesPerCourse = 0.0;
+    double internedBytesPerCourse = 0.0;
+};
+
+/**
+ * @brief Measure the memory footprint of the batch's distinct courses held
+ *        as Course values, in a CatalogStore, in a HashTable and a
+ *        RedBlackTree, and as an InternedCatalog.
+ */
+MemoryFootprintResult RunMemoryFootprintBenchmark(const CourseBatch& batch);
+
+/**
+ * @brief Department and level-band queries answered three ways: a full walk
+ *        over a HashTable, an ordered prefix seek in a RedBlackTree, and a
+ *        DepartmentIndex jump. Walk and seek decompose every number they
+ *        visit and keep only DepartmentIndex's matches (exact department;
+ *        three-digit numbers of the level), so all rows count the same set.
+ *        Each timing covers RANGE_QUERY_REPEATS queries.
+ */
+struct DepartmentRangeResult {
+    std::string datasetName;
+    std::string department;          // e.g. "PHYS"
+    uint32_t level = 0;              // e.g. 300
+    long long indexBuildMs = 0;      // DepartmentIndex::Build over the loaded tree
+    long long walkDepartmentMs = 0;  // HashTable::ForEach, filtered to the department
+    long long seekDepartmentMs = 0;  // RedBlackTree::PrefixQuery(department), filtered
+    long long indexDepartmentMs = 0; // DepartmentIndex::Department
+    long long walkLevelMs = 0;       // HashTable::ForEach, filtered to the level
+    long long seekLevelMs = 0;       // RedBlackTree::PrefixQuery(department + level digit), filtered
+    long long indexLevelMs = 0;      // DepartmentIndex::LevelBand(level, level)
+    size_t walkDepartmentMatches = 0;
+    size_t seekDepartmentMatches = 0;
+    size_t indexDepartmentMatches = 0;
+    size_t walkLevelMatches = 0;
+    size_t seekLevelMatches = 0;
+    size_t indexLevelMatches = 0;
+};
+
+/**
+ * @brief Time "everything in <department>" and "all <level>-level
+ *        <department> courses" by full walk, prefix seek and DepartmentIndex.
+ * @param department Department letters, e.g. "PHYS" (case-insensitive).
+ * @param level      Level in hundreds, e.g. 300.
+ */
+DepartmentRangeResult RunDepartmentRangeBenchmark(const CourseBatch& batch,
+    const std::string& department, uint32_t level);
+
+/**
+ * @brief Write a synthetic catalog in the loader's CSV format.
+ * @param filePath Output path (overwritten).
+ * @param rows     Number of course lines to write.
+ * @param seed     RNG seed, so the same arguments give the same file.
+ * @return False if the file could not be written.
  */
-std::vector<std::string> LoadCourseNumbersOnly(const std::string& filePath);
+bool GenerateCatalogFile(const std::string& filePath, size_t rows, unsigned int seed = 2024);
@@ -0,0 +1,322 @@
+#include "CatalogSnapshot.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+using namespace std;
+
+namespace {
+    constexpr char MAGIC[8] = { 'C', 'O', 'U', 'R', 'S', 'N', 'A', 'P' };
+    constexpr uint32_t BYTE_ORDER_MARK = 0x01020304u;
+    constexpr uint32_t EMPTY_SLOT = UINT32_MAX;
+
+    /**
+     * @brief 64-bit checksum over a byte range, eight bytes per step.
+     *        Catches truncation and bit rot, not deliberate tampering.
+     */
+    uint64_t Checksum(const char* data, size_t length) {
+        uint64_t h = 0x9e3779b97f4a7c15ULL ^ length;
+        size_t i = 0;
+        for (; i + 8 <= length; i += 8) {
+            uint64_t word;
+            memcpy(&word, data + i, 8);
+            h = (h ^ word) * 0xff51afd7ed558ccdULL;
+            h ^= h >> 29;
+        }
+        for (; i < length; ++i) {
+            h = (h ^ static_cast<unsigned char>(data[i])) * 0xc4ceb9fe1a85ec53ULL;
+        }
+        return h ^ (h >> 32);
+    }
+
+    /** Size and modification stamp of a file; false if it cannot be read. */
+    bool StatFile(const string& path, uint64_t& bytes, int64_t& stamp) {
+        error_code ec;
+        uintmax_t size = filesystem::file_size(path, ec);
+        if (ec) return false;
+        auto modified = filesystem::last_write_time(path, ec);
+        if (ec) return false;
+        bytes = size;
+        stamp = static_cast<int64_t>(modified.time_since_epoch().count());
+        return true;
+    }
+
+    /** Smallest power of two holding `count` keys at most half full. */
+    size_t SlotCountFor(size_t count) {
+        size_t slots = 2;
+        while (slots < count * 2) slots <<= 1;
+        return slots;
+    }
+}
+
+struct CatalogSnapshot::Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t headerBytes;
+    uint64_t recordCount;
+    uint64_t prerequisiteCount;
+    uint64_t slotCount;
+    uint64_t blobBytes;
+    uint64_t sourceBytes;
+    int64_t sourceStamp;
+    uint64_t checksum; // over every byte after the header
+};
+
+struct CatalogSnapshot::StringRef {
+    uint32_t offset; // into the string blob
+    uint32_t length;
+};
+
+struct CatalogSnapshot::RecordEntry {
+    StringRef number;
+    StringRef title;
+    uint32_t firstPrerequisite; // into the prerequisite table
+    uint32_t prerequisiteCount;
+};
+
+CatalogSnapshot::CatalogSnapshot()
+    : header(nullptr), heads(nullptr), records(nullptr), prerequisites(nullptr), slots(nullptr), blob(nullptr) {
+}
+
+// --- Writing ---
+bool CatalogSnapshot::Write(const string& snapshotPath, const RedBlackTree& tree, const string& sourcePath) {
+    vector<uint64_t> keyHeads;
+    vector<RecordEntry> table;
+    vector<StringRef> prereqTable;
+    string strings;
+    keyHeads.reserve(tree.Size());
+    table.reserve(tree.Size());
+
+    auto addString = [&](string_view s) {
+        StringRef ref{ static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(s.size()) };
+        strings += s;
+        return ref;
+        };
+
+    for (CourseView course : tree) {
+        RecordEntry entry;
+        entry.number = addString(course.number);
+        entry.title = addString(course.title);
+        entry.firstPrerequisite = static_cast<uint32_t>(prereqTable.size());
+        entry.prerequisiteCount = static_cast<uint32_t>(course.prerequisites.size());
+        for (string_view p : course.prerequisites) prereqTable.push_back(addString(p));
+        keyHeads.push_back(PackCourseKeyHead(course.number));
+        table.push_back(entry);
+    }
+    if (strings.size() > UINT32_MAX || prereqTable.size() > UINT32_MAX) {
+        cout << "Error: Catalog is too large for a snapshot." << endl;
+        return false;
+    }
+
+    // Records are in key order, so a slot holds a sorted position
+    vector<uint32_t> slotTable(SlotCountFor(table.size()), EMPTY_SLOT);
+    size_t mask = slotTable.size() - 1;
+    for (uint32_t position = 0; position < table.size(); ++position) {
+        const StringRef& number = table[position].number;
+        size_t slot = HashCourseKey(string_view(strings.data() + number.offset, number.length)) & mask;
+        while (slotTable[slot] != EMPTY_SLOT) slot = (slot + 1) & mask;
+        slotTable[slot] = position;
+    }
+
+    string payload;
+    auto appendArray = [&](const auto& v) {
+        payload.append(reinterpret_cast<const char*>(v.data()), v.size() * sizeof(v[0]));
+        };
+    appendArray(keyHeads);
+    appendArray(table);
+    appendArray(prereqTable);
+    appendArray(slotTable);
+    payload += strings;
+
+    Header h{};
+    memcpy(h.magic, MAGIC, sizeof(MAGIC));
+    h.version = FORMAT_VERSION;
+    h.byteOrder = BYTE_ORDER_MARK;
+    h.headerBytes = sizeof(Header);
+    h.recordCount = table.size();
+    h.prerequisiteCount = prereqTable.size();
+    h.slotCount = slotTable.size();
+    h.blobBytes = strings.size();
+    StatFile(sourcePath, h.sourceBytes, h.sourceStamp);
+    h.checksum = Checksum(payload.data(), payload.size());
+
+    string tempPath = snapshotPath + ".tmp";
+    {
+        ofstream out(tempPath, ios::binary | ios::trunc);
+        out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        out.write(payload.data(), static_cast<streamsize>(payload.size()));
+        if (!out) {
+            cout << "Error: Could not write snapshot: " << snapshotPath << endl;
+            return false;
+        }
+    }
+    error_code ec;
+    filesystem::rename(tempPath, snapshotPath, ec);
+    if (ec) {
+        filesystem::remove(tempPath, ec);
+        cout << "Error: Could not write snapshot: " << snapshotPath << endl;
+        return false;
+    }
+    return true;
+}
+
+// --- Opening ---
+bool CatalogSnapshot::IsSnapshotFile(const string& path) {
+    char magic[sizeof(MAGIC)] = {};
+    ifstream in(path, ios::binary);
+    return in.read(magic, sizeof(magic)) && memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+/**
+ * @brief Validate the header, the section sizes against the file size, the
+ *        checksum, and finally every reference into the blob and tables, so
+ *        a lookup never has to bounds-check.
+ */
+bool CatalogSnapshot::Open(const string& snapshotPath) {
+    Close();
+    if (!file.Open(snapshotPath)) return false;
+    string_view bytes = file.Text();
+
+    const Header* h = reinterpret_cast<const Header*>(bytes.data());
+    if (bytes.size() < sizeof(Header) || memcmp(h->magic, MAGIC, sizeof(MAGIC)) != 0
+        || h->version != FORMAT_VERSION || h->byteOrder != BYTE_ORDER_MARK
+        || h->headerBytes != sizeof(Header)) {
+        Close();
+        return false;
+    }
+
+    // Counts are bounded by the file size before any multiplication
+    uint64_t payloadBytes = bytes.size() - sizeof(Header);
+    if (h->recordCount > UINT32_MAX || h->prerequisiteCount > UINT32_MAX || h->slotCount > payloadBytes
+        || h->slotCount <= h->recordCount || (h->slotCount & (h->slotCount - 1)) != 0
+        || h->recordCount * (sizeof(uint64_t) + sizeof(RecordEntry)) + h->prerequisiteCount * sizeof(StringRef)
+        + h->slotCount * sizeof(uint32_t) + h->blobBytes != payloadBytes) {
+        Close();
+        return false;
+    }
+
+    const char* payload = bytes.data() + sizeof(Header);
+    if (Checksum(payload, payloadBytes) != h->checksum) {
+        Close();
+        return false;
+    }
+
+    const char* cursor = payload;
+    heads = reinterpret_cast<const uint64_t*>(cursor);
+    cursor += h->recordCount * sizeof(uint64_t);
+    records = reinterpret_cast<const RecordEntry*>(cursor);
+    cursor += h->recordCount * sizeof(RecordEntry);
+    prerequisites = reinterpret_cast<const StringRef*>(cursor);
+    cursor += h->prerequisiteCount * sizeof(StringRef);
+    slots = reinterpret_cast<const uint32_t*>(cursor);
+    cursor += h->slotCount * sizeof(uint32_t);
+    blob = cursor;
+
+    auto inBlob = [&](const StringRef& ref) { return uint64_t(ref.offset) + ref.length <= h->blobBytes; };
+    bool valid = true;
+    for (uint64_t i = 0; i < h->recordCount && valid; ++i) {
+        const RecordEntry& r = records[i];
+        valid = inBlob(r.number) && inBlob(r.title)
+            && uint64_t(r.firstPrerequisite) + r.prerequisiteCount <= h->prerequisiteCount;
+    }
+    for (uint64_t i = 0; i < h->prerequisiteCount && valid; ++i) valid = inBlob(prerequisites[i]);
+    for (uint64_t i = 0; i < h->slotCount && valid; ++i) valid = slots[i] == EMPTY_SLOT || slots[i] < h->recordCount;
+    if (!valid) {
+        Close();
+        return false;
+    }
+
+    header = h;
+    return true;
+}
+
+bool CatalogSnapshot::MatchesSource(const string& sourcePath) const {
+    if (!header) return false;
+    uint64_t bytes = 0;
+    int64_t stamp = 0;
+    if (!StatFile(sourcePath, bytes, stamp)) return true; // nothing to be stale against
+    return bytes == header->sourceBytes && stamp == header->sourceStamp;
+}
+
+void CatalogSnapshot::Close() {
+    file.Close();
+    header = nullptr;
+    heads = nullptr;
+    records = nullptr;
+    prerequisites = nullptr;
+    slots = nullptr;
+    blob = nullptr;
+}
+
+bool CatalogSnapshot::IsOpen() const {
+    return header != nullptr;
+}
+
+// --- Lookups ---
+string_view CatalogSnapshot::String(const StringRef& ref) const {
+    return string_view(blob + ref.offset, ref.length);
+}
+
+CatalogSnapshot::Record CatalogSnapshot::Find(string_view courseNumber) const {
+    if (!header) return Record(nullptr, 0);
+    size_t mask = header->slotCount - 1;
+    for (size_t slot = HashCourseKey(courseNumber) & mask; slots[slot] != EMPTY_SLOT; slot = (slot + 1) & mask) {
+        if (CourseKeyEquals(String(records[slots[slot]].number), courseNumber)) {
+            return Record(this, slots[slot]);
+        }
+    }
+    return Record(nullptr, 0);
+}
+
+size_t CatalogSnapshot::LowerBound(string_view courseNumber) const {
+    uint64_t head = PackCourseKeyHead(courseNumber);
+    size_t lo = 0;
+    size_t hi = Size();
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        bool less = heads[mid] != head ? heads[mid] < head
+            : CompareCourseKeys(String(records[mid].number), courseNumber) < 0;
+        if (less) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+CatalogSnapshot::Record CatalogSnapshot::At(size_t position) const {
+    return Record(this, static_cast<uint32_t>(position));
+}
+
+void CatalogSnapshot::ForEach(const function<void(const Record&)>& fn) const {
+    for (size_t i = 0; i < Size(); ++i) fn(At(i));
+}
+
+size_t CatalogSnapshot::Size() const {
+    return header ? static_cast<size_t>(header->recordCount) : 0;
+}
+
+// --- Record ---
+string_view CatalogSnapshot::Record::Number() const {
+    return owner->String(owner->records[position].number);
+}
+
+string_view CatalogSnapshot::Record::Title() const {
+    return owner->String(owner->records[position].title);
+}
+
+size_t CatalogSnapshot::Record::PrerequisiteCount() const {
+    return owner->records[position].prerequisiteCount;
+}
+
+string_view CatalogSnapshot::Record::Prerequisite(size_t i) const {
+    return owner->String(owner->prerequisites[owner->records[position].firstPrerequisite + i]);
+}
+
+Course CatalogSnapshot::Record::ToCourse() const {
+    Course course;
+    course.number.assign(Number());
+    course.title.assign(Title());
+    course.prerequisites.reserve(PrerequisiteCount());
+    for (size_t i = 0; i < PrerequisiteCount(); ++i) course.prerequisites.emplace_back(Prerequisite(i));
+    return course;
+}
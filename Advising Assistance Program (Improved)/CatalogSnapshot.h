@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Course.h"
+#include "MappedFile.h"
+#include "RedBlackTree.h"
+
+/**
+ * @file CatalogSnapshot.h
+ * @brief Compiled binary form of a parsed catalog, queried straight out of
+ *        a memory mapping.
+ *
+ * Parsing CSV on every launch redoes the same work each time. After a
+ * successful load the catalog is written once as a snapshot; later opens map
+ * the file and read it in place: no parsing, no per-record allocation.
+ *
+ * File layout (native byte order, every section 8-byte aligned):
+ *  - Header: magic, format version, byte-order mark, section counts, the
+ *    size and modification stamp of the source CSV, and a checksum over
+ *    everything after the header.
+ *  - Key heads: PackCourseKeyHead of each course number, in sorted order
+ *    (a binary search reads only this array until two heads tie).
+ *  - Record table: fixed-size records in sorted key order, each holding
+ *    blob offsets/lengths of its number and title and a run of prerequisites.
+ *  - Prerequisite table: blob offset/length per prerequisite.
+ *  - Hash slots: open-addressed table of record positions keyed by
+ *    HashCourseKey, for O(1) exact lookup.
+ *  - String blob: every string the records refer to.
+ *
+ * Open() rejects a file whose magic, version, byte order, section sizes or
+ * checksum do not match, so a stale or damaged snapshot is never served.
+ */
+class CatalogSnapshot {
+public:
+    /** Bumped whenever the layout, hash function or key folding changes. */
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    /** Extension appended to a CSV path to name its snapshot. */
+    static constexpr const char* EXTENSION = ".snap";
+
+    /**
+     * @brief Lightweight handle to one record of an open snapshot. The views
+     *        it returns point into the mapping and live as long as it does.
+     */
+    class Record {
+    public:
+        std::string_view Number() const;
+        std::string_view Title() const;
+        size_t PrerequisiteCount() const;
+        std::string_view Prerequisite(size_t i) const;
+
+        /** @return An owning Course copy of this record. */
+        Course ToCourse() const;
+
+        /** @return False for the "not found" handle returned by Find. */
+        explicit operator bool() const { return owner != nullptr; }
+
+    private:
+        friend class CatalogSnapshot;
+        Record(const CatalogSnapshot* o, uint32_t p) : owner(o), position(p) {}
+        const CatalogSnapshot* owner = nullptr;
+        uint32_t position = 0;
+    };
+
+    CatalogSnapshot();
+
+    /**
+     * @brief Write the tree's courses as a snapshot of `sourcePath`.
+     *        The file is written under a temporary name and renamed into
+     *        place, so readers never see a half-written snapshot.
+     * @return False if the file could not be written (an error is printed).
+     */
+    static bool Write(const std::string& snapshotPath, const RedBlackTree& tree,
+        const std::string& sourcePath);
+
+    /** @return True if the file starts with the snapshot magic (any version). */
+    static bool IsSnapshotFile(const std::string& path);
+
+    /**
+     * @brief Map and validate a snapshot, replacing any open one.
+     * @return False if the file is missing, of another format version, or
+     *         fails its size or checksum checks.
+     */
+    bool Open(const std::string& snapshotPath);
+
+    /**
+     * @return True if `sourcePath` still has the size and modification time
+     *         recorded when the snapshot was written (or no longer exists).
+     */
+    bool MatchesSource(const std::string& sourcePath) const;
+
+    /** @brief Unmap the snapshot. */
+    void Close();
+
+    /** @return True if a valid snapshot is open. */
+    bool IsOpen() const;
+
+    /**
+     * @brief Exact lookup by catalog number (case-insensitive).
+     * @return Handle to the record; tests false if not found.
+     */
+    Record Find(std::string_view courseNumber) const;
+
+    /**
+     * @return Sorted position of the first course whose key is not less than
+     *         `courseNumber` (case-insensitive), in [0, Size()].
+     */
+    size_t LowerBound(std::string_view courseNumber) const;
+
+    /** @return Record at a sorted position (must be < Size()). */
+    Record At(size_t position) const;
+
+    /** @brief Visit every record in ascending key order. */
+    void ForEach(const std::function<void(const Record&)>& fn) const;
+
+    /** @return Number of courses in the snapshot. */
+    size_t Size() const;
+
+private:
+    struct Header;
+    struct RecordEntry;
+    struct StringRef;
+
+    MappedFile file;
+    const Header* header;
+    const uint64_t* heads;
+    const RecordEntry* records;
+    const StringRef* prerequisites;
+    const uint32_t* slots;
+    const char* blob;
+
+    std::string_view String(const StringRef& ref) const;
+};
@@ -0,0 +1,189 @@
+#include "CatalogStore.h"
+using namespace std;
+
+namespace {
+    /** Dead arena bytes tolerated before compaction is considered at all. */
+    constexpr size_t MIN_COMPACT_BYTES = 64 * 1024;
+}
+
+Course CourseView::ToCourse() const {
+    Course course;
+    course.number.assign(number);
+    course.title.assign(title);
+    course.prerequisites.reserve(prerequisites.size());
+    for (string_view p : prerequisites) course.prerequisites.emplace_back(p);
+    return course;
+}
+
+CatalogStore::CatalogStore() : deadBytes(0) {}
+
+// --- Arenas ---
+CatalogStore::TextRef CatalogStore::AppendText(string_view s) {
+    TextRef ref{ static_cast<uint32_t>(text.size()), static_cast<uint32_t>(s.size()) };
+    text.append(s.data(), s.size());
+    return ref;
+}
+
+template <typename Names>
+CatalogStore::IdRange CatalogStore::AppendPrerequisites(const Names& names) {
+    IdRange range{ static_cast<uint32_t>(prerequisiteIds.size()), static_cast<uint32_t>(names.size()) };
+    for (string_view name : names) prerequisiteIds.push_back(prerequisiteNames.Intern(name));
+    return range;
+}
+
+void CatalogStore::Retire(uint32_t id) {
+    deadBytes += numbers[id].length + titles[id].length + prerequisites[id].count * sizeof(uint32_t);
+}
+
+/**
+ * @brief Copy every live record's bytes into fresh arenas in ID order.
+ *        Only offsets change, so record IDs held by indexes stay valid.
+ */
+void CatalogStore::CompactIfWasteful() {
+    size_t usedBytes = text.size() + prerequisiteIds.size() * sizeof(uint32_t);
+    if (deadBytes < MIN_COMPACT_BYTES || deadBytes * 2 < usedBytes) return;
+
+    string liveText;
+    vector<uint32_t> liveIds;
+    liveText.reserve(text.size());
+    for (size_t id = 0; id < numbers.size(); ++id) {
+        auto relocate = [&](TextRef& ref) {
+            uint32_t offset = static_cast<uint32_t>(liveText.size());
+            liveText.append(text, ref.offset, ref.length);
+            ref.offset = offset;
+            };
+        relocate(numbers[id]);
+        relocate(titles[id]);
+
+        IdRange& range = prerequisites[id];
+        uint32_t first = static_cast<uint32_t>(liveIds.size());
+        liveIds.insert(liveIds.end(), prerequisiteIds.begin() + range.first,
+            prerequisiteIds.begin() + range.first + range.count);
+        range.first = first;
+    }
+    text.swap(liveText);
+    prerequisiteIds.swap(liveIds);
+    deadBytes = 0;
+}
+
+// --- Records ---
+uint32_t CatalogStore::Add(const Course& course) {
+    return Add(CourseKey(course.number), course);
+}
+
+uint32_t CatalogStore::Add(const CourseKey& key, const Course& course) {
+    TextRef number = AppendText(course.number);
+    TextRef title = AppendText(course.title);
+    return Place(key, number, title, AppendPrerequisites(course.prerequisites));
+}
+
+uint32_t CatalogStore::Add(const CourseKey& key, string_view number, string_view title,
+    const vector<string_view>& prerequisiteNumbers) {
+    TextRef numberRef = AppendText(number);
+    TextRef titleRef = AppendText(title);
+    return Place(key, numberRef, titleRef, AppendPrerequisites(prerequisiteNumbers));
+}
+
+uint32_t CatalogStore::Place(const CourseKey& key, TextRef number, TextRef title, IdRange range) {
+    if (!freeIds.empty()) {
+        uint32_t id = freeIds.back();
+        freeIds.pop_back();
+        keys[id] = key;
+        numbers[id] = number;
+        titles[id] = title;
+        prerequisites[id] = range;
+        return id;
+    }
+    keys.push_back(key);
+    numbers.push_back(number);
+    titles.push_back(title);
+    prerequisites.push_back(range);
+    return static_cast<uint32_t>(numbers.size() - 1);
+}
+
+void CatalogStore::Reserve(size_t records, size_t textBytes, size_t prerequisiteCount) {
+    text.reserve(text.size() + textBytes);
+    keys.reserve(keys.size() + records);
+    numbers.reserve(numbers.size() + records);
+    titles.reserve(titles.size() + records);
+    prerequisites.reserve(prerequisites.size() + records);
+    prerequisiteIds.reserve(prerequisiteIds.size() + prerequisiteCount);
+}
+
+/**
+ * @brief Fields that did not change keep their arena bytes, so re-upserting
+ *        an identical record (the common term-update case) appends nothing.
+ */
+void CatalogStore::Replace(uint32_t id, const Course& course) {
+    if (Number(id) != course.number) {
+        deadBytes += numbers[id].length;
+        keys[id] = CourseKey(course.number);
+        numbers[id] = AppendText(course.number);
+    }
+
+    const TextRef& title = titles[id];
+    if (string_view(text.data() + title.offset, title.length) != course.title) {
+        deadBytes += title.length;
+        titles[id] = AppendText(course.title);
+    }
+
+    IdRange& range = prerequisites[id];
+    bool samePrerequisites = range.count == course.prerequisites.size();
+    for (uint32_t i = 0; samePrerequisites && i < range.count; ++i) {
+        samePrerequisites = prerequisiteNames.Get(prerequisiteIds[range.first + i]) == course.prerequisites[i];
+    }
+    if (!samePrerequisites) {
+        deadBytes += range.count * sizeof(uint32_t);
+        prerequisites[id] = AppendPrerequisites(course.prerequisites);
+    }
+    CompactIfWasteful();
+}
+
+void CatalogStore::Remove(uint32_t id) {
+    Retire(id);
+    keys[id] = CourseKey();
+    numbers[id] = TextRef{ 0, 0 };
+    titles[id] = TextRef{ 0, 0 };
+    prerequisites[id] = IdRange{ 0, 0 };
+    freeIds.push_back(id);
+    CompactIfWasteful();
+}
+
+CourseView CatalogStore::View(uint32_t id) const {
+    const TextRef& title = titles[id];
+    const IdRange& range = prerequisites[id];
+    CourseView view;
+    view.number = Number(id);
+    view.title = string_view(text.data() + title.offset, title.length);
+    view.prerequisites = PrerequisiteList(prerequisiteIds.data() + range.first, range.count, &prerequisiteNames);
+    view.record = id;
+    return view;
+}
+
+// --- Size ---
+size_t CatalogStore::Size() const {
+    return numbers.size() - freeIds.size();
+}
+
+size_t CatalogStore::MemoryBytes() const {
+    return text.capacity()
+        + keys.capacity() * sizeof(CourseKey)
+        + numbers.capacity() * sizeof(TextRef)
+        + titles.capacity() * sizeof(TextRef)
+        + prerequisites.capacity() * sizeof(IdRange)
+        + prerequisiteIds.capacity() * sizeof(uint32_t)
+        + prerequisiteNames.MemoryBytes()
+        + freeIds.capacity() * sizeof(uint32_t);
+}
+
+void CatalogStore::Clear() {
+    text.clear();
+    keys.clear();
+    numbers.clear();
+    titles.clear();
+    prerequisites.clear();
+    prerequisiteIds.clear();
+    prerequisiteNames.Clear();
+    freeIds.clear();
+    deadBytes = 0;
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Course.h"
+#include "CourseKey.h"
+#include "StringInterner.h"
+
+/**
+ * @file CatalogStore.h
+ * @brief Structure-of-arrays course storage addressed by 32-bit record IDs.
+ *
+ * A Course owns three heap members, so every container that stores Course
+ * values keeps its own copies of every string. A CatalogStore keeps each
+ * record's number and title as slices of one character arena and its
+ * prerequisites as a span of interned IDs (see StringInterner) in one ID
+ * array, and its number's CourseKey in a flat key array. An index then stores
+ * only a 4-byte record ID, compares keys as integers, and hands callers a
+ * CourseView: string_views into the arenas, no allocation.
+ *
+ * Record IDs stay stable until the record is removed; removed IDs are reused
+ * by later Adds. Replacing or removing a record leaves its old bytes in the
+ * arenas until they outweigh the live ones, at which point the arenas are
+ * compacted (IDs do not change). Views are invalidated by any mutation.
+ */
+
+/**
+ * @brief Read-only list of a record's prerequisite numbers, as string_views.
+ */
+class PrerequisiteList {
+public:
+    class Iterator {
+    public:
+        Iterator(const uint32_t* p, const StringInterner* n) : id(p), names(n) {}
+        std::string_view operator*() const { return names->Get(*id); }
+        Iterator& operator++() { ++id; return *this; }
+        bool operator==(const Iterator& other) const { return id == other.id; }
+        bool operator!=(const Iterator& other) const { return id != other.id; }
+
+    private:
+        const uint32_t* id;
+        const StringInterner* names;
+    };
+
+    PrerequisiteList() : first(nullptr), count(0), names(nullptr) {}
+    PrerequisiteList(const uint32_t* f, uint32_t c, const StringInterner* n) : first(f), count(c), names(n) {}
+
+    Iterator begin() const { return Iterator(first, names); }
+    Iterator end() const { return Iterator(first + count, names); }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    std::string_view operator[](size_t i) const { return names->Get(first[i]); }
+
+private:
+    const uint32_t* first;
+    uint32_t count;
+    const StringInterner* names;
+};
+
+/**
+ * @brief Non-owning view of one stored course. Field names mirror Course, so
+ *        read-only code works on either; ToCourse() makes an owning copy.
+ *        A default-constructed view means "not found" and tests false.
+ */
+struct CourseView {
+    /** Record ID of a view that refers to no course. */
+    static constexpr uint32_t NO_RECORD = UINT32_MAX;
+
+    std::string_view number;
+    std::string_view title;
+    PrerequisiteList prerequisites;
+    uint32_t record = NO_RECORD; // ID in the owning CatalogStore
+
+    explicit operator bool() const { return record != NO_RECORD; }
+
+    /** @return An owning Course copy of the viewed record. */
+    Course ToCourse() const;
+};
+
+class CatalogStore {
+public:
+    CatalogStore();
+
+    /** @return ID of a new record holding a copy of `course`. */
+    uint32_t Add(const Course& course);
+
+    /** @brief Add with the key already packed (`key` must be CourseKey(course.number)). */
+    uint32_t Add(const CourseKey& key, const Course& course);
+
+    /**
+     * @brief Add from borrowed fields, e.g. views into a mapped snapshot, so
+     *        no Course has to be built first. `key` must be CourseKey(number).
+     */
+    uint32_t Add(const CourseKey& key, std::string_view number, std::string_view title,
+        const std::vector<std::string_view>& prerequisiteNumbers);
+
+    /**
+     * @brief Pre-size the arrays for a bulk load so they carry no growth slack.
+     * @param records      Number of records about to be added.
+     * @param textBytes    Total bytes of their numbers and titles.
+     * @param prerequisiteCount Total prerequisite entries across them.
+     */
+    void Reserve(size_t records, size_t textBytes, size_t prerequisiteCount);
+
+    /** @brief Overwrite record `id` with `course`. */
+    void Replace(uint32_t id, const Course& course);
+
+    /** @brief Free record `id`; the ID may be handed out again by Add. */
+    void Remove(uint32_t id);
+
+    /** @return View of record `id`. */
+    CourseView View(uint32_t id) const;
+
+    /** @return Catalog number of record `id` (index comparisons use only this). */
+    std::string_view Number(uint32_t id) const {
+        const TextRef& ref = numbers[id];
+        return std::string_view(text.data() + ref.offset, ref.length);
+    }
+
+    /** @return Packed key of record `id`'s number. */
+    const CourseKey& Key(uint32_t id) const { return keys[id]; }
+
+    /** @return Number of live records. */
+    size_t Size() const;
+
+    /** @return Bytes held by every arena and array (capacity). */
+    size_t MemoryBytes() const;
+
+    /** @brief Remove every record. */
+    void Clear();
+
+private:
+    struct TextRef {
+        uint32_t offset; // into text
+        uint32_t length;
+    };
+    struct IdRange {
+        uint32_t first;  // into prerequisiteIds
+        uint32_t count;
+    };
+
+    std::string text;                     // numbers and titles, back to back
+    std::vector<CourseKey> keys;          // per record: packed number
+    std::vector<TextRef> numbers;         // per record
+    std::vector<TextRef> titles;          // per record
+    std::vector<IdRange> prerequisites;   // per record
+    std::vector<uint32_t> prerequisiteIds; // every record's span, back to back
+    StringInterner prerequisiteNames;     // prerequisite numbers, interned
+    std::vector<uint32_t> freeIds;        // removed records available for reuse
+    size_t deadBytes;                     // arena bytes no live record refers to
+
+    TextRef AppendText(std::string_view s);
+    template <typename Names>
+    IdRange AppendPrerequisites(const Names& names);
+
+    /** Store the refs under a free or new ID. */
+    uint32_t Place(const CourseKey& key, TextRef number, TextRef title, IdRange range);
+
+    /** Account for a record's arena bytes becoming unreachable. */
+    void Retire(uint32_t id);
+
+    /** Rewrite the arenas with only live records once dead bytes dominate. */
+    void CompactIfWasteful();
+};
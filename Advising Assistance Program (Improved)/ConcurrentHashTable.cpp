@@ -0,0 +1,124 @@
+#include "ConcurrentHashTable.h"
+using namespace std;
+
+namespace {
+    /** Initial bucket count for each shard's table. */
+    constexpr unsigned int SHARD_INITIAL_BUCKETS = 64;
+}
+
+// --- Lifecycle ---
+ConcurrentHashTable::ConcurrentHashTable() {
+    for (Shard& shard : shards) {
+        shard.table.store(new HashTable(SHARD_INITIAL_BUCKETS));
+    }
+}
+
+ConcurrentHashTable::~ConcurrentHashTable() {
+    for (Shard& shard : shards) {
+        delete shard.table.load();
+    }
+}
+
+size_t ConcurrentHashTable::ShardOf(string_view courseNumber) {
+    return static_cast<size_t>(HashCourseKey(courseNumber) >> 58) & (SHARD_COUNT - 1);
+}
+
+// --- Writers ---
+const HashTable* ConcurrentHashTable::Replace(Shard& shard, const function<void(HashTable&)>& change) {
+    lock_guard<mutex> guard(shard.writeLock);
+    const HashTable* current = shard.table.load();
+    HashTable* updated = new HashTable(*current);
+    change(*updated);
+    shard.table.store(updated);
+    return current;
+}
+
+/**
+ * @brief Copy-on-write upsert of one course into its shard.
+ */
+void ConcurrentHashTable::Insert(Course course) {
+    const HashTable* retired = Replace(shards[ShardOf(course.number)], [&](HashTable& table) {
+        table.Insert(std::move(course));
+        });
+    readers.WaitForReaders();
+    delete retired;
+}
+
+/**
+ * @brief Group courses by shard, publish each touched shard once, then free
+ *        every replaced table after one shared grace period.
+ */
+void ConcurrentHashTable::InsertBatch(vector<Course> courses) {
+    array<vector<Course>, SHARD_COUNT> perShard;
+    for (Course& c : courses) {
+        perShard[ShardOf(c.number)].push_back(std::move(c));
+    }
+
+    vector<const HashTable*> retired;
+    for (size_t i = 0; i < SHARD_COUNT; ++i) {
+        if (perShard[i].empty()) continue;
+        retired.push_back(Replace(shards[i], [&](HashTable& table) {
+            for (Course& c : perShard[i]) table.Insert(std::move(c));
+            }));
+    }
+
+    if (retired.empty()) return;
+    readers.WaitForReaders();
+    for (const HashTable* table : retired) delete table;
+}
+
+bool ConcurrentHashTable::Erase(string_view courseNumber) {
+    bool removed = false;
+    const HashTable* retired = Replace(shards[ShardOf(courseNumber)], [&](HashTable& table) {
+        removed = table.Erase(courseNumber);
+        });
+    readers.WaitForReaders();
+    delete retired;
+    return removed;
+}
+
+void ConcurrentHashTable::Clear() {
+    vector<const HashTable*> retired;
+    for (Shard& shard : shards) {
+        lock_guard<mutex> guard(shard.writeLock);
+        retired.push_back(shard.table.exchange(new HashTable(SHARD_INITIAL_BUCKETS)));
+    }
+    readers.WaitForReaders();
+    for (const HashTable* table : retired) delete table;
+}
+
+// --- Readers ---
+Course ConcurrentHashTable::Search(string courseNumber) const {
+    ReaderEpoch::ReadGuard guard(readers);
+    CourseView found = shards[ShardOf(courseNumber)].table.load(memory_order_acquire)->Find(courseNumber);
+    return found ? found.ToCourse() : Course();
+}
+
+bool ConcurrentHashTable::Contains(string_view courseNumber) const {
+    ReaderEpoch::ReadGuard guard(readers);
+    return static_cast<bool>(shards[ShardOf(courseNumber)].table.load(memory_order_acquire)->Find(courseNumber));
+}
+
+bool ConcurrentHashTable::Visit(string_view courseNumber, const function<void(const CourseView&)>& fn) const {
+    ReaderEpoch::ReadGuard guard(readers);
+    CourseView found = shards[ShardOf(courseNumber)].table.load(memory_order_acquire)->Find(courseNumber);
+    if (!found) return false;
+    fn(found);
+    return true;
+}
+
+void ConcurrentHashTable::ForEach(const function<void(const CourseView&)>& fn) const {
+    for (const Shard& shard : shards) {
+        ReaderEpoch::ReadGuard guard(readers);
+        shard.table.load(memory_order_acquire)->ForEach(fn);
+    }
+}
+
+size_t ConcurrentHashTable::Size() const {
+    size_t n = 0;
+    for (const Shard& shard : shards) {
+        ReaderEpoch::ReadGuard guard(readers);
+        n += shard.table.load(memory_order_acquire)->Size();
+    }
+    return n;
+}
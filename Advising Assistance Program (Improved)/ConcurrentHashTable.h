@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <functional>
+#include "Course.h"
+#include "HashTable.h"
+#include "ReaderEpoch.h"
+
+/**
+ * @file ConcurrentHashTable.h
+ * @brief Read-mostly, thread-safe course index for multi-threaded lookups.
+ *
+ * Keys are spread over SHARD_COUNT shards by the high bits of their hash. Each
+ * shard publishes an immutable HashTable through an atomic pointer:
+ *  - Readers are lock-free. They announce themselves in a per-thread stripe
+ *    counter for the current epoch, load the shard pointer, probe it and
+ *    leave. They never wait for a writer.
+ *  - Writers lock only the shard they modify, copy its table, apply the
+ *    change and publish the copy. The replaced table is freed after a
+ *    ReaderEpoch grace period, once every reader that could have loaded it
+ *    has left (RCU style). Writers to
+ *    different shards copy in parallel; InsertBatch publishes every touched
+ *    shard and then waits for a single grace period.
+ *
+ * Because a table may be retired as soon as a call returns, lookups hand back
+ * copies (or run a visitor inside the read-side section) rather than pointers
+ * into the table.
+ */
+class ConcurrentHashTable {
+public:
+    /** Number of independently locked shards (power of two). */
+    static constexpr size_t SHARD_COUNT = 64;
+
+    ConcurrentHashTable();
+    ~ConcurrentHashTable();
+
+    ConcurrentHashTable(const ConcurrentHashTable&) = delete;
+    ConcurrentHashTable& operator=(const ConcurrentHashTable&) = delete;
+
+    /**
+     * @brief Insert or update a single course. Thread-safe.
+     * @param course Course value to upsert; the key is course.number.
+     */
+    void Insert(Course course);
+
+    /**
+     * @brief Upsert many courses, publishing each touched shard once.
+     *        Later entries win over earlier ones with the same key.
+     * @param courses Courses to upsert; consumed by the call.
+     */
+    void InsertBatch(std::vector<Course> courses);
+
+    /**
+     * @brief Remove a course by catalog number. Thread-safe.
+     * @return True if a course was removed.
+     */
+    bool Erase(std::string_view courseNumber);
+
+    /**
+     * @brief Lookup a course by catalog number (case-insensitive). Lock-free.
+     * @return Copy of the matching Course, or a default Course if not found.
+     */
+    Course Search(std::string courseNumber) const;
+
+    /** @return True if the catalog currently holds the course. Lock-free. */
+    bool Contains(std::string_view courseNumber) const;
+
+    /**
+     * @brief Run `fn` on the stored course inside the read-side section,
+     *        avoiding a copy. `fn` must not call writer methods.
+     * @return True if the course was found and `fn` was called.
+     */
+    bool Visit(std::string_view courseNumber, const std::function<void(const CourseView&)>& fn) const;
+
+    /**
+     * @brief Apply a function to every course of a consistent per-shard view.
+     *        `fn` must not call writer methods.
+     */
+    void ForEach(const std::function<void(const CourseView&)>& fn) const;
+
+    /** @return Number of stored courses (sum over shards). */
+    size_t Size() const;
+
+    /** @brief Remove all courses. */
+    void Clear();
+
+private:
+    struct Shard {
+        std::atomic<const HashTable*> table; // published table; replaced, never mutated
+        std::mutex writeLock;                // serializes writers of this shard
+    };
+
+    std::array<Shard, SHARD_COUNT> shards;
+    mutable ReaderEpoch readers; // grace periods for retired tables
+
+    /**
+     * @return Shard index for a key: the top bits of HashCourseKey. HashTable
+     *         picks buckets with CourseKey::Hash, an unrelated hash, so keys
+     *         within one shard still spread over its buckets.
+     */
+    static size_t ShardOf(std::string_view courseNumber);
+
+    /** Copy a shard's table, apply `change`, publish it and return the old table. */
+    const HashTable* Replace(Shard& shard, const std::function<void(HashTable&)>& change);
+};
@@ -1,4 +1,5 @@
 #include "Course.h"
+#include <utility>
 
 /**
  * Default constructor: initialize an empty/placeholder course. This is returned
@@ -13,12 +14,11 @@ Course::Course() {
 /**
  * Value constructor: populate the three fields directly. No normalization or
  * validation is performed here by design; the FileLoader is responsible for
- * input sanitation.
+ * input sanitation. Arguments are taken by value and moved into place, so
+ * callers passing temporaries pay for no copies.
  */
-Course::Course(std::string number, std::string title, std::vector<std::string> prerequisites) {
-    this->number = number;
-    this->title = title;
-    this->prerequisites = prerequisites;
+Course::Course(std::string number, std::string title, std::vector<std::string> prerequisites)
+    : number(std::move(number)), title(std::move(title)), prerequisites(std::move(prerequisites)) {
 }
 
 /**
@@ -28,3 +28,53 @@ Course::Course(std::string number, std::string title, std::vector<std::string> p
 bool operator<(const Course& a, const Course& b) {
     return a.number < b.number;
 }
+
+/**
+ * Keys are compared character by character after folding, so lookups never
+ * need an uppercased copy of either side.
+ */
+bool CourseKeyEquals(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (FoldKeyChar(a[i]) != FoldKeyChar(b[i])) return false;
+    }
+    return true;
+}
+
+/**
+ * FNV-1a over the folded characters followed by a murmur3-style finalizer, so
+ * keys that differ only in digit order ("CS201" vs "CS210") hash far apart.
+ */
+uint64_t HashCourseKey(std::string_view key) {
+    uint64_t h = 1469598103934665603ULL;
+    for (char ch : key) {
+        h ^= static_cast<unsigned char>(FoldKeyChar(ch));
+        h *= 1099511628211ULL;
+    }
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+uint64_t PackCourseKeyHead(std::string_view key) {
+    uint64_t head = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        unsigned char ch = i < key.size() ? static_cast<unsigned char>(FoldKeyChar(key[i])) : 0;
+        head = (head << 8) | ch;
+    }
+    return head;
+}
+
+int CompareCourseKeys(std::string_view a, std::string_view b) {
+    size_t n = a.size() < b.size() ? a.size() : b.size();
+    for (size_t i = 0; i < n; ++i) {
+        unsigned char ca = static_cast<unsigned char>(FoldKeyChar(a[i]));
+        unsigned char cb = static_cast<unsigned char>(FoldKeyChar(b[i]));
+        if (ca != cb) return ca < cb ? -1 : 1;
+    }
+    if (a.size() == b.size()) return 0;
+    return a.size() < b.size() ? -1 : 1;
+}
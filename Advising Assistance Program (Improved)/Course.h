@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 
 /**
@@ -8,10 +10,12 @@
  * @brief Minimal data model for a university course record.
  *
  * A Course encapsulates a catalog identifier (e.g., "CS101"), a human-readable
- * title, and an ordered list of prerequisite course identifiers. This struct is
- * intentionally lightweight and trivially copyable to make it practical as the
- * value payload in containers such as the open-addressed HashTable and the
- * RedBlackTree used throughout this project.
+ * title, and an ordered list of prerequisite course identifiers, each in its
+ * own owning string. It is the form in which records enter the indexes (the
+ * loaders build Courses) and the owning copy handed back by the APIs that
+ * return a Course by value, such as RedBlackTree::Search and
+ * CourseView::ToCourse. The HashTable and RedBlackTree do not store Courses:
+ * they keep records in a CatalogStore and hand out CourseViews.
  */
 struct Course {
     /** Catalog key, e.g., "CS101". Used as the unique lookup key in indexes. */
@@ -45,3 +49,36 @@ struct Course {
  * use a container that compares case-insensitively.
  */
 bool operator<(const Course& a, const Course& b);
+
+/**
+ * @brief ASCII uppercase fold applied to catalog keys before comparison.
+ *        Locale-independent so every index agrees on what "equal" means.
+ */
+inline char FoldKeyChar(char ch) {
+    return (ch >= 'a' && ch <= 'z') ? static_cast<char>(ch - ('a' - 'A')) : ch;
+}
+
+/**
+ * @brief Case-insensitive equality of two catalog keys, without allocating.
+ */
+bool CourseKeyEquals(std::string_view a, std::string_view b);
+
+/**
+ * @brief Case-insensitive three-way comparison of two catalog keys, without
+ *        allocating. Orders exactly like comparing the uppercased strings.
+ * @return Negative if a < b, positive if a > b, 0 if equal.
+ */
+int CompareCourseKeys(std::string_view a, std::string_view b);
+
+/**
+ * @brief Pack the first 8 folded bytes of a key big-endian, zero padded.
+ *        Integer order of heads matches CompareCourseKeys order of the keys'
+ *        8-byte prefixes, so ordered indexes can compare most keys as integers.
+ */
+uint64_t PackCourseKeyHead(std::string_view key);
+
+/**
+ * @brief Well-mixed 64-bit hash of a catalog key, case-insensitive.
+ *        Shared by every hashed index so they agree on key identity.
+ */
+uint64_t HashCourseKey(std::string_view key);
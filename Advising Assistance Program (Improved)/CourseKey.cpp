@@ -0,0 +1,21 @@
+#include "CourseKey.h"
+#include "Course.h"
+#include <algorithm>
+using namespace std;
+
+CourseKey::CourseKey(string_view key) : high(0), low(0) {
+    size_t stored = min(key.size(), INLINE_BYTES);
+    for (size_t i = 0; i < 8; ++i) {
+        unsigned char ch = i < stored ? static_cast<unsigned char>(FoldKeyChar(key[i])) : 0;
+        high = (high << 8) | ch;
+    }
+    for (size_t i = 8; i < INLINE_BYTES; ++i) {
+        unsigned char ch = i < stored ? static_cast<unsigned char>(FoldKeyChar(key[i])) : 0;
+        low = (low << 8) | ch;
+    }
+    low = (low << 8) | (key.size() > INLINE_BYTES ? OVERSIZED : static_cast<uint8_t>(key.size()));
+}
+
+int CourseKey::CompareTails(string_view a, string_view b) {
+    return CompareCourseKeys(a.substr(min(a.size(), INLINE_BYTES)), b.substr(min(b.size(), INLINE_BYTES)));
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @file CourseKey.h
+ * @brief A course number normalized into two 64-bit words.
+ *
+ * Course numbers are short ("CS101", "MATH2410"), so the folded key fits in
+ * a fixed-width value: bytes 0-14 hold the uppercased characters big-endian,
+ * zero padded, and byte 15 holds the length. Comparing two keys is then two
+ * integer compares, equality is two integer compares, and the hash mixes two
+ * words instead of walking a string. The packed order matches
+ * CompareCourseKeys exactly: equal characters leave the length to decide, and
+ * a shorter key is a prefix of the longer one.
+ *
+ * Keys longer than INLINE_BYTES keep their first INLINE_BYTES characters and
+ * mark byte 15 OVERSIZED. Two such keys that share those characters compare
+ * equal here; callers then settle the tie with CompareTails on the original
+ * text. Oversized keys with a shared prefix also share a hash.
+ */
+class CourseKey {
+public:
+    /** Characters stored inline; longer keys need the CompareTails fallback. */
+    static constexpr size_t INLINE_BYTES = 15;
+
+    /** Length byte of a key longer than INLINE_BYTES. Sorts after every real length. */
+    static constexpr uint8_t OVERSIZED = 0xFF;
+
+    /** The empty key. */
+    CourseKey() : high(0), low(0) {}
+
+    /** Fold and pack `key`. */
+    explicit CourseKey(std::string_view key);
+
+    /** @return False if the key is longer than INLINE_BYTES. */
+    bool IsInline() const { return static_cast<uint8_t>(low) != OVERSIZED; }
+
+    /** @return The first 8 folded bytes, big-endian (same value as PackCourseKeyHead). */
+    uint64_t Head() const { return high; }
+
+    /**
+     * @brief Three-way comparison of the packed words.
+     * @return Negative, zero or positive like CompareCourseKeys. Zero is exact
+     *         unless both keys are oversized (see CompareTails).
+     */
+    int Compare(const CourseKey& other) const {
+        if (high != other.high) return high < other.high ? -1 : 1;
+        if (low != other.low) return low < other.low ? -1 : 1;
+        return 0;
+    }
+
+    /** @return True if the packed words match; exact for inline keys. */
+    bool operator==(const CourseKey& other) const { return high == other.high && low == other.low; }
+    bool operator!=(const CourseKey& other) const { return !(*this == other); }
+
+    /** @return Well-mixed 64-bit hash of the packed words. */
+    uint64_t Hash() const {
+        uint64_t h = high * 0x9E3779B97F4A7C15ULL;
+        h ^= low + 0x632BE59BD9B4E019ULL + (h << 6) + (h >> 2);
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    /**
+     * @brief Settle a tie between two oversized keys by comparing the
+     *        characters past INLINE_BYTES (case-insensitive).
+     * @param a, b The full key text of each side.
+     */
+    static int CompareTails(std::string_view a, std::string_view b);
+
+private:
+    uint64_t high; // folded bytes 0-7, big-endian
+    uint64_t low;  // folded bytes 8-14, big-endian, then the length byte
+};
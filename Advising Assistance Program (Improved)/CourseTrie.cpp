@@ -0,0 +1,230 @@
+#include "CourseTrie.h"
+#include <algorithm>
+using namespace std;
+
+namespace {
+    /** Byte order used for sibling lists; matches CompareCourseKeys. */
+    inline unsigned char KeyByte(char ch) {
+        return static_cast<unsigned char>(FoldKeyChar(ch));
+    }
+}
+
+CourseTrie::CourseTrie() {
+    Clear();
+}
+
+uint32_t CourseTrie::NewNode(uint32_t labelOffset, uint32_t labelLength, uint32_t record) {
+    unsigned char firstByte = labelLength > 0 ? static_cast<unsigned char>(labels[labelOffset]) : 0;
+    nodes.push_back(TrieNode{ labelOffset, static_cast<uint16_t>(labelLength), firstByte, NONE, NONE, record });
+    return static_cast<uint32_t>(nodes.size() - 1);
+}
+
+uint32_t CourseTrie::ChildStartingWith(uint32_t node, char ch) const {
+    unsigned char target = KeyByte(ch);
+    for (uint32_t child = nodes[node].firstChild; child != NONE; child = nodes[child].nextSibling) {
+        unsigned char first = nodes[child].firstByte;
+        if (first == target) return child;
+        if (first > target) break; // siblings are ordered
+    }
+    return NONE;
+}
+
+void CourseTrie::AddChild(uint32_t parent, uint32_t child) {
+    unsigned char first = nodes[child].firstByte;
+    uint32_t* link = &nodes[parent].firstChild;
+    while (*link != NONE && nodes[*link].firstByte < first) {
+        link = &nodes[*link].nextSibling;
+    }
+    nodes[child].nextSibling = *link;
+    *link = child;
+}
+
+// --- Insert ---
+/**
+ * @brief Follow matching edges; on a partial match split the edge in place
+ *        (the lower half keeps the old children and record), then either
+ *        mark the node where the key ends or hang a new leaf for the rest.
+ */
+void CourseTrie::Insert(const Course& course) {
+    string key = course.number;
+    for (char& ch : key) ch = FoldKeyChar(ch);
+
+    uint32_t node = 0;
+    size_t pos = 0;
+    while (true) {
+        if (pos == key.size()) {
+            if (nodes[node].record == NONE) {
+                nodes[node].record = static_cast<uint32_t>(records.size());
+                records.push_back(course);
+            }
+            else {
+                records[nodes[node].record] = course; // duplicate: replace payload
+            }
+            return;
+        }
+
+        uint32_t child = ChildStartingWith(node, key[pos]);
+        if (child == NONE) {
+            uint32_t offset = static_cast<uint32_t>(labels.size());
+            labels.append(key, pos, string::npos);
+            uint32_t leaf = NewNode(offset, static_cast<uint32_t>(key.size() - pos),
+                static_cast<uint32_t>(records.size()));
+            records.push_back(course);
+            AddChild(node, leaf);
+            return;
+        }
+
+        uint32_t labelOffset = nodes[child].labelOffset;
+        uint32_t labelLength = nodes[child].labelLength;
+        uint32_t matched = 0;
+        while (matched < labelLength && pos + matched < key.size()
+            && labels[labelOffset + matched] == key[pos + matched]) {
+            ++matched;
+        }
+
+        if (matched < labelLength) {
+            // Split: child keeps the matched head, a new node takes the tail
+            uint32_t tail = NewNode(labelOffset + matched, labelLength - matched, nodes[child].record);
+            nodes[tail].firstChild = nodes[child].firstChild;
+            nodes[child].labelLength = static_cast<uint16_t>(matched);
+            nodes[child].firstChild = tail;
+            nodes[child].record = NONE;
+        }
+        node = child;
+        pos += matched;
+    }
+}
+
+// --- Lookups ---
+const Course* CourseTrie::Find(string_view courseNumber) const {
+    uint32_t node = 0;
+    size_t pos = 0;
+    while (pos < courseNumber.size()) {
+        uint32_t child = ChildStartingWith(node, courseNumber[pos]);
+        if (child == NONE) return nullptr;
+
+        const TrieNode& edge = nodes[child];
+        if (courseNumber.size() - pos < edge.labelLength) return nullptr;
+        for (uint32_t i = 0; i < edge.labelLength; ++i) {
+            if (labels[edge.labelOffset + i] != FoldKeyChar(courseNumber[pos + i])) return nullptr;
+        }
+        node = child;
+        pos += edge.labelLength;
+    }
+    uint32_t record = nodes[node].record;
+    return record == NONE ? nullptr : &records[record];
+}
+
+Course CourseTrie::Search(string courseNumber) const {
+    const Course* found = Find(courseNumber);
+    return found ? *found : Course();
+}
+
+uint32_t CourseTrie::LocatePrefix(string_view prefix) const {
+    uint32_t node = 0;
+    size_t pos = 0;
+    while (pos < prefix.size()) {
+        uint32_t child = ChildStartingWith(node, prefix[pos]);
+        if (child == NONE) return NONE;
+
+        const TrieNode& edge = nodes[child];
+        size_t compare = min<size_t>(edge.labelLength, prefix.size() - pos);
+        for (size_t i = 0; i < compare; ++i) {
+            if (labels[edge.labelOffset + i] != FoldKeyChar(prefix[pos + i])) return NONE;
+        }
+        node = child;
+        pos += compare;
+    }
+    return node;
+}
+
+/**
+ * @brief Preorder walk is ascending key order here: a node's key is a prefix
+ *        of (so sorts before) every key below it, and siblings are ordered.
+ */
+void CourseTrie::VisitSubtree(uint32_t start, const function<bool(const Course&)>& fn) const {
+    vector<uint32_t> pending{ start };
+    while (!pending.empty()) {
+        uint32_t node = pending.back();
+        pending.pop_back();
+
+        const TrieNode& n = nodes[node];
+        if (n.record != NONE && !fn(records[n.record])) return;
+        if (node != start && n.nextSibling != NONE) pending.push_back(n.nextSibling);
+        if (n.firstChild != NONE) pending.push_back(n.firstChild);
+    }
+}
+
+size_t CourseTrie::PrefixQuery(string_view prefix, const function<void(const Course&)>& visitor) const {
+    uint32_t node = LocatePrefix(prefix);
+    if (node == NONE) return 0;
+
+    size_t visited = 0;
+    VisitSubtree(node, [&](const Course& course) {
+        visitor(course);
+        ++visited;
+        return true;
+        });
+    return visited;
+}
+
+vector<string> CourseTrie::Complete(string_view prefix, size_t limit) const {
+    vector<string> matches;
+    uint32_t node = LocatePrefix(prefix);
+    if (node == NONE || limit == 0) return matches;
+
+    VisitSubtree(node, [&](const Course& course) {
+        matches.push_back(course.number);
+        return matches.size() < limit;
+        });
+    return matches;
+}
+
+// --- Iteration ---
+void CourseTrie::ForEach(const function<void(const Course&)>& fn) const {
+    VisitSubtree(0, [&](const Course& course) {
+        fn(course);
+        return true;
+        });
+}
+
+size_t CourseTrie::Size() const {
+    return records.size();
+}
+
+size_t CourseTrie::StructureBytes() const {
+    return nodes.capacity() * sizeof(TrieNode) + labels.capacity();
+}
+
+/**
+ * @brief Breadth-first renumbering: a node's children are queued together,
+ *        so they receive consecutive indices and a sibling scan reads
+ *        adjacent entries instead of jumping around the vector.
+ */
+void CourseTrie::Compact() {
+    vector<TrieNode> ordered;
+    ordered.reserve(nodes.size());
+    ordered.push_back(nodes[0]);
+
+    // ordered[i] still holds old child/sibling links until it is processed
+    for (size_t i = 0; i < ordered.size(); ++i) {
+        uint32_t oldChild = ordered[i].firstChild;
+        if (oldChild == NONE) continue;
+
+        ordered[i].firstChild = static_cast<uint32_t>(ordered.size());
+        while (oldChild != NONE) {
+            ordered.push_back(nodes[oldChild]);
+            oldChild = nodes[oldChild].nextSibling;
+            ordered.back().nextSibling = oldChild == NONE ? NONE : static_cast<uint32_t>(ordered.size());
+        }
+    }
+    nodes.swap(ordered);
+    nodes.shrink_to_fit();
+}
+
+void CourseTrie::Clear() {
+    nodes.clear();
+    labels.clear();
+    records.clear();
+    NewNode(0, 0, NONE); // root
+}
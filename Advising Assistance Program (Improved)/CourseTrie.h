@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <functional>
+#include "Course.h"
+
+/**
+ * @file CourseTrie.h
+ * @brief Compressed (radix) trie over normalized course numbers.
+ *
+ * Course numbers are a department code followed by a number ("CS201",
+ * "PHYS308"), so keys share long prefixes: every CS course hangs below one
+ * "CS" edge. Each edge holds a run of key bytes, so a chain of single-child
+ * nodes collapses into one node.
+ *
+ * Layout is compact and pointer-free: nodes live in one vector and refer to
+ * each other by 32-bit index. Edge labels are slices of one shared byte
+ * buffer, so splitting an edge only adjusts offsets. Children form a sibling
+ * list ordered by first byte; the alphabet (A-Z, 0-9, a few symbols) keeps
+ * those lists short. Course records are stored densely in insertion order.
+ *
+ *  - Exact lookup compares each key byte once: O(key length).
+ *  - Prefix enumeration walks the prefix, then visits only the subtree below
+ *    it, in ascending key order: O(prefix + matches).
+ *
+ * Keys are case-insensitive like every other index in the project.
+ */
+class CourseTrie {
+public:
+    CourseTrie();
+
+    /**
+     * @brief Insert a course keyed by its catalog number.
+     *        If the number already exists, replaces the stored Course.
+     */
+    void Insert(const Course& course);
+
+    /**
+     * @brief Zero-copy lookup by catalog number (case-insensitive).
+     * @return Pointer to the stored Course, or nullptr if not found. The
+     *         pointer is invalidated by the next Insert.
+     */
+    const Course* Find(std::string_view courseNumber) const;
+
+    /**
+     * @brief Lookup returning a copy, mirroring the other indexes' Search.
+     * @return Matching Course, or a default-constructed Course if not found.
+     */
+    Course Search(std::string courseNumber) const;
+
+    /**
+     * @brief Visit every course whose key starts with `prefix`
+     *        (case-insensitive, e.g. "cs2") in ascending order.
+     * @return Number of courses visited.
+     */
+    size_t PrefixQuery(std::string_view prefix, const std::function<void(const Course&)>& visitor) const;
+
+    /**
+     * @brief Autocomplete: up to `limit` course numbers starting with
+     *        `prefix`, in ascending order.
+     */
+    std::vector<std::string> Complete(std::string_view prefix, size_t limit) const;
+
+    /** @brief Apply a function to each stored course in ascending order. */
+    void ForEach(const std::function<void(const Course&)>& fn) const;
+
+    /** @return Number of stored courses. */
+    size_t Size() const;
+
+    /** @return Bytes used by the trie structure itself (nodes and labels, not records). */
+    size_t StructureBytes() const;
+
+    /** @brief Remove all courses. */
+    void Clear();
+
+    /**
+     * @brief Renumber nodes breadth-first so every sibling list is one
+     *        contiguous run in memory. Worth calling once after a bulk load;
+     *        later inserts stay correct but append out of order.
+     */
+    void Compact();
+
+private:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    struct TrieNode {
+        uint32_t labelOffset; // Edge label: labels[labelOffset, +labelLength).
+        uint16_t labelLength;
+        unsigned char firstByte; // labels[labelOffset], kept here for sibling scans.
+        uint32_t firstChild;  // Smallest child, or NONE.
+        uint32_t nextSibling; // Next larger sibling, or NONE.
+        uint32_t record;      // Index into records if a key ends here, else NONE.
+    };
+
+    std::vector<TrieNode> nodes; // nodes[0] is the root (empty label)
+    std::string labels;          // folded key bytes referenced by edge labels
+    std::vector<Course> records;
+
+    uint32_t NewNode(uint32_t labelOffset, uint32_t labelLength, uint32_t record);
+
+    /** @return Child of `node` whose label starts with `ch`, or NONE. */
+    uint32_t ChildStartingWith(uint32_t node, char ch) const;
+
+    /** Link `child` into `parent`'s sibling list, keeping first-byte order. */
+    void AddChild(uint32_t parent, uint32_t child);
+
+    /**
+     * Walk `prefix` from the root. Returns the node whose subtree holds every
+     * key with that prefix (the walk may stop inside its edge), or NONE.
+     */
+    uint32_t LocatePrefix(std::string_view prefix) const;
+
+    /** In-order visit of the records below `node`; stops when `fn` returns false. */
+    void VisitSubtree(uint32_t node, const std::function<bool(const Course&)>& fn) const;
+};
@@ -0,0 +1,122 @@
+#include "DepartmentIndex.h"
+#include "RedBlackTree.h"
+#include <algorithm>
+using namespace std;
+
+DepartmentIndex::DepartmentIndex() {
+    Clear();
+}
+
+// --- Decomposition ---
+bool DepartmentIndex::ParseCourseNumber(string_view courseNumber, CourseCode& code) {
+    auto isLetter = [](char ch) { return (ch >= 'A' && ch <= 'Z') || (ch >= 'a' && ch <= 'z'); };
+    size_t letters = 0;
+    while (letters < courseNumber.size() && isLetter(courseNumber[letters])) ++letters;
+
+    size_t digits = courseNumber.size() - letters;
+    if (letters == 0 || digits == 0 || digits > 9) return false;
+
+    uint32_t number = 0;
+    for (size_t i = letters; i < courseNumber.size(); ++i) {
+        char ch = courseNumber[i];
+        if (ch < '0' || ch > '9') return false;
+        number = number * 10 + static_cast<uint32_t>(ch - '0');
+    }
+
+    // Only the usual three-digit numbers encode a level in their first digit
+    code.department = courseNumber.substr(0, letters);
+    code.level = digits == 3 ? static_cast<uint32_t>(courseNumber[letters] - '0') * 100 : NO_LEVEL;
+    code.number = number;
+    return true;
+}
+
+// --- Build ---
+/**
+ * @brief Decompose every number in the tree's store, then place entries with
+ *        a counting sort on (department, run) and order each run by number.
+ *        The tree's key order breaks ties, so equal numbers ("CS0101",
+ *        "CS00101") stay put.
+ */
+void DepartmentIndex::Build(const RedBlackTree& tree) {
+    Clear();
+    source = &tree.Store();
+
+    struct Pending {
+        uint32_t run;    // department * RUNS + level digit, or + LEVELS without a level
+        Entry entry;
+    };
+    vector<Pending> pending;
+    pending.reserve(tree.Size());
+    for (CourseView course : tree) {
+        CourseCode code;
+        if (!ParseCourseNumber(course.number, code)) {
+            ++unindexed;
+            continue;
+        }
+        uint32_t department = departments.Intern(code.department);
+        uint32_t run = code.level == NO_LEVEL ? LEVELS : code.level / 100;
+        pending.push_back(Pending{ department * RUNS + run, Entry{ code.number, course.record } });
+    }
+
+    // Counting sort into runs; runStarts[r] ends up at the start of run r
+    runStarts.assign(departments.Size() * RUNS + 1, 0);
+    for (const Pending& p : pending) ++runStarts[p.run + 1];
+    for (size_t run = 1; run < runStarts.size(); ++run) runStarts[run] += runStarts[run - 1];
+
+    entries.resize(pending.size());
+    vector<uint32_t> fill(runStarts.begin(), runStarts.end() - 1);
+    for (const Pending& p : pending) entries[fill[p.run]++] = p.entry;
+
+    for (size_t run = 0; run + 1 < runStarts.size(); ++run) {
+        stable_sort(entries.begin() + runStarts[run], entries.begin() + runStarts[run + 1],
+            [](const Entry& a, const Entry& b) { return a.number < b.number; });
+    }
+}
+
+// --- Queries ---
+size_t DepartmentIndex::Scan(size_t first, size_t last, const function<void(const CourseView&)>& visitor) const {
+    for (size_t i = first; i < last; ++i) visitor(source->View(entries[i].record));
+    return last - first;
+}
+
+size_t DepartmentIndex::Department(string_view department, const function<void(const CourseView&)>& visitor) const {
+    uint32_t id = departments.Find(department);
+    if (id == StringInterner::NOT_FOUND) return 0;
+    return Scan(runStarts[id * RUNS], runStarts[(id + 1) * RUNS], visitor);
+}
+
+size_t DepartmentIndex::LevelBand(string_view department, uint32_t loLevel, uint32_t hiLevel,
+    const function<void(const CourseView&)>& visitor) const {
+    uint32_t id = departments.Find(department);
+    uint32_t loDigit = loLevel / 100;
+    uint32_t hiDigit = min(hiLevel / 100, LEVELS - 1);
+    if (id == StringInterner::NOT_FOUND || loDigit > hiDigit) return 0;
+    return Scan(runStarts[id * RUNS + loDigit], runStarts[id * RUNS + hiDigit + 1], visitor);
+}
+
+// --- Size ---
+size_t DepartmentIndex::Size() const {
+    return entries.size();
+}
+
+size_t DepartmentIndex::DepartmentCount() const {
+    return departments.Size();
+}
+
+size_t DepartmentIndex::Unindexed() const {
+    return unindexed;
+}
+
+size_t DepartmentIndex::MemoryBytes() const {
+    return departments.MemoryBytes()
+        + runStarts.capacity() * sizeof(uint32_t)
+        + entries.capacity() * sizeof(Entry);
+}
+
+void DepartmentIndex::Clear() {
+    source = nullptr;
+    departments.Clear();
+    runStarts.assign(1, 0);
+    entries.clear();
+    unindexed = 0;
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <functional>
+#include "CatalogStore.h"
+#include "StringInterner.h"
+
+class RedBlackTree;
+
+/**
+ * @file DepartmentIndex.h
+ * @brief Secondary index over a RedBlackTree that groups its courses by
+ *        department and level, addressed by integers.
+ *
+ * A course number such as "PHYS301" is decomposed into a department
+ * ("PHYS", interned to a dense ID), a level (300) and the numeric part
+ * itself (301). Entries hold the tree's record IDs, sorted by (department,
+ * level, number) in one array, and `runStarts` records where every
+ * (department, level) run begins. "Everything in BIO" or "all 300-level
+ * PHYS courses" is then a direct jump to a run plus a contiguous scan, with
+ * no string comparisons at all. The records themselves stay in the tree's
+ * CatalogStore; the index keeps no copy of them.
+ *
+ * Levels are defined for three-digit numbers only: the level is the leading
+ * digit in hundreds (PHYS301 -> 300). Other widths (HIST62052, CS1010) have
+ * no level. They are still listed by Department(), after the levelled
+ * courses, but never by LevelBand(). Numbers that are not letters followed
+ * by 1-9 digits cannot be decomposed; they are left out of the index and
+ * counted by Unindexed().
+ *
+ * The index refers to the tree's records by ID, so it must be rebuilt after
+ * the tree changes and not used after the tree is cleared or destroyed.
+ */
+class DepartmentIndex {
+public:
+    /** Levels per department: leading digits 0-9, reported as 0, 100, ..., 900. */
+    static constexpr uint32_t LEVELS = 10;
+
+    /** CourseCode::level of a number that is not three digits wide. */
+    static constexpr uint32_t NO_LEVEL = UINT32_MAX;
+
+    /** A course number split into its parts. */
+    struct CourseCode {
+        std::string_view department; // letters, as written
+        uint32_t level;              // leading digit * 100, or NO_LEVEL
+        uint32_t number;             // numeric part as an integer
+    };
+
+    /**
+     * @brief Decompose a course number ("PHYS301" -> PHYS, 300, 301;
+     *        "HIST62052" -> HIST, NO_LEVEL, 62052).
+     * @return False if the number is not letters followed by 1-9 digits.
+     */
+    static bool ParseCourseNumber(std::string_view courseNumber, CourseCode& code);
+
+    DepartmentIndex();
+
+    /** @brief Index the current contents of a tree, replacing any previous build. */
+    void Build(const RedBlackTree& tree);
+
+    /**
+     * @brief Visit every course of a department (case-insensitive), ordered
+     *        by level, then number; courses without a level come last.
+     * @return Number of courses visited.
+     */
+    size_t Department(std::string_view department, const std::function<void(const CourseView&)>& visitor) const;
+
+    /**
+     * @brief Visit the courses of a department whose level lies in
+     *        [loLevel, hiLevel], e.g. (300, 300) for "300-level" or (100, 200)
+     *        for lower-division. Levels are in hundreds.
+     * @return Number of courses visited.
+     */
+    size_t LevelBand(std::string_view department, uint32_t loLevel, uint32_t hiLevel,
+        const std::function<void(const CourseView&)>& visitor) const;
+
+    /** @return Number of indexed courses, with or without a level. */
+    size_t Size() const;
+
+    /** @return Number of distinct departments. */
+    size_t DepartmentCount() const;
+
+    /** @return Courses left out because their number could not be decomposed. */
+    size_t Unindexed() const;
+
+    /** @return Bytes held by the entries, run table and interner (capacity); excludes the tree. */
+    size_t MemoryBytes() const;
+
+    /** @brief Remove every entry and department. */
+    void Clear();
+
+private:
+    /** Runs per department: one per level, then one for numbers without a level. */
+    static constexpr uint32_t RUNS = LEVELS + 1;
+
+    struct Entry {
+        uint32_t number; // numeric part; the level is implied by the run
+        uint32_t record; // ID in the source tree's CatalogStore
+    };
+
+    const CatalogStore* source;      // the indexed tree's records
+    StringInterner departments;      // department letters -> dense ID
+    std::vector<uint32_t> runStarts; // first entry of run (department * RUNS + run), plus end
+    std::vector<Entry> entries;      // sorted by department, run, number
+    size_t unindexed;
+
+    /** Visit entries [first, last). */
+    size_t Scan(size_t first, size_t last, const std::function<void(const CourseView&)>& visitor) const;
+};
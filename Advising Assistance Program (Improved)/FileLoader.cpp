@@ -1,7 +1,12 @@
 #include "FileLoader.h"
+#include "MappedFile.h"
+#include "CourseKey.h"
+#include <algorithm>
 #include <fstream>
+#include <future>
 #include <iostream>
-#include <sstream>
+#include <string_view>
+#include <thread>
 using namespace std;
 
 /**
@@ -18,53 +23,180 @@ namespace {
         }
         return lineCount;
     }
-}
 
-/**
- * @brief Load courses into a HashTable from a CSV-like file.
- *        Format: COURSE_NUMBER,COURSE_TITLE[,PREREQ_1,PREREQ_2,...]
- * @note Skips lines with missing number or title and prints a warning.
- */
-void loadCourses(HashTable& courseTable, const string& fileName) {
-    ifstream file(fileName);
-    if (!file.is_open()) {
-        cout << "Error: Could not open file: " << fileName << endl;
-        return;
+    /** Requested parser thread count; 0 means one per hardware thread. */
+    size_t loaderThreads = 0;
+
+    /** Record, key and line-number-of-malformed-line buffers for one chunk. */
+    struct ParsedChunk {
+        vector<Course> records;
+        vector<CourseKey> keys;        // keys[i] packs records[i].number
+        vector<size_t> malformedLines; // relative to the chunk's first line
+        size_t lineCount = 0;
+    };
+
+    void warnMalformedLine(size_t lineNumber) {
+        cout << "Warning: Line " << lineNumber
+            << " skipped due to incorrect formatting." << endl;
+    }
+
+    /**
+     * @brief Tokenize CSV-like course text in place and hand each valid record
+     *        to `sink` as (CourseKey, Course&&). Fields are string_views into
+     *        `text`; the only copies made are the Course's own strings, once
+     *        per record. The key is packed from the number token directly, so
+     *        keyed indexes never re-derive it from the stored string.
+     *        Format: COURSE_NUMBER,COURSE_TITLE[,PREREQ_1,PREREQ_2,...]
+     * @param text      Whole lines of the file (LF or CRLF endings).
+     * @param malformed Called with the 1-based line number (within `text`) of
+     *                  each line with a missing number or title.
+     * @return Number of lines in `text`.
+     */
+    template <typename Sink, typename Malformed>
+    size_t parseCourseText(string_view text, Sink& sink, Malformed& malformed) {
+        size_t lineNumber = 0;
+        size_t pos = 0;
+        while (pos < text.size()) {
+            size_t end = text.find('\n', pos);
+            if (end == string_view::npos) end = text.size();
+            string_view line = text.substr(pos, end - pos);
+            pos = end + 1;
+            ++lineNumber;
+
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            if (line.empty()) continue;
+
+            // Parse number and title (required); a line without a title
+            // field at all is ignored
+            size_t numberEnd = line.find(',');
+            if (numberEnd == string_view::npos) continue;
+            string_view courseNumber = line.substr(0, numberEnd);
+            string_view rest = line.substr(numberEnd + 1);
+            if (rest.empty()) continue;
+
+            size_t titleEnd = rest.find(',');
+            string_view courseName = rest.substr(0, titleEnd);
+
+            // Validate required fields
+            if (courseNumber.empty() || courseName.empty()) {
+                malformed(lineNumber);
+                continue;
+            }
+
+            CourseKey key(courseNumber);
+            Course course;
+            course.number.assign(courseNumber);
+            course.title.assign(courseName);
+
+            // Parse any remaining comma-separated values as prerequisites
+            while (titleEnd != string_view::npos) {
+                size_t tokenStart = titleEnd + 1;
+                titleEnd = rest.find(',', tokenStart);
+                string_view token = rest.substr(tokenStart,
+                    titleEnd == string_view::npos ? string_view::npos : titleEnd - tokenStart);
+                if (!token.empty()) course.prerequisites.emplace_back(token);
+            }
+
+            sink(key, std::move(course));
+        }
+        return lineNumber;
     }
 
-    string line;
-    int lineNumber = 0;
-    while (getline(file, line)) {
-        ++lineNumber;
-        if (line.empty()) continue;
-
-        istringstream ss(line);
-        string courseNumber;
-        string courseName;
-        vector<string> prerequisites;
-        string token;
-
-        // Parse number and title (required)
-        if (!getline(ss, courseNumber, ',')) continue;
-        if (!getline(ss, courseName, ',')) continue;
-
-        // Validate required fields
-        if (courseNumber.empty() || courseName.empty()) {
-            cout << "Warning: Line " << lineNumber
-                << " skipped due to incorrect formatting." << endl;
-            continue;
+    /**
+     * @brief Split text into about `parts` pieces, each ending just after a
+     *        newline (the last ends at the end of the text).
+     */
+    vector<string_view> splitAtLines(string_view text, size_t parts) {
+        vector<string_view> chunks;
+        size_t start = 0;
+        for (size_t i = 1; i <= parts && start < text.size(); ++i) {
+            size_t end = text.size();
+            if (i < parts) {
+                size_t newline = text.find('\n', max(start, text.size() / parts * i));
+                if (newline != string_view::npos) end = newline + 1;
+            }
+            chunks.push_back(text.substr(start, end - start));
+            start = end;
         }
+        return chunks;
+    }
 
-        // Parse any remaining comma-separated values as prerequisites
-        while (getline(ss, token, ',')) {
-            if (!token.empty()) prerequisites.push_back(token);
+    /**
+     * @brief Map a course file and parse it; the single parse loop behind
+     *        every loader. Files of at least PARALLEL_MIN_CHUNK_BYTES per
+     *        thread are split at line boundaries and parsed in parallel into
+     *        per-chunk buffers. Chunks are handed to `sink` strictly in file
+     *        order as each finishes, so index inserts overlap with parsing of
+     *        later chunks, repeated keys still resolve last-wins, and warnings
+     *        carry file line numbers.
+     * @return False if the file could not be opened (an error is printed).
+     */
+    template <typename Sink>
+    bool forEachCourseInFile(const string& fileName, Sink&& sink) {
+        MappedFile file;
+        if (!file.Open(fileName)) {
+            cout << "Error: Could not open file: " << fileName << endl;
+            return false;
         }
+        string_view text = file.Text();
 
-		// Insert new Course into the HashTable
-        courseTable.Insert(Course(courseNumber, courseName, prerequisites));
+        size_t threads = loaderThreads > 0 ? loaderThreads : max<size_t>(1, thread::hardware_concurrency());
+        size_t parts = min(threads, max<size_t>(1, text.size() / PARALLEL_MIN_CHUNK_BYTES));
+        if (parts <= 1) {
+            parseCourseText(text, sink, warnMalformedLine);
+            return true;
+        }
+
+        vector<future<ParsedChunk>> pending;
+        for (string_view chunk : splitAtLines(text, parts)) {
+            pending.push_back(async(launch::async, [chunk]() {
+                ParsedChunk parsed;
+                auto keep = [&](const CourseKey& key, Course&& course) {
+                    parsed.keys.push_back(key);
+                    parsed.records.push_back(std::move(course));
+                    };
+                auto note = [&](size_t line) { parsed.malformedLines.push_back(line); };
+                parsed.lineCount = parseCourseText(chunk, keep, note);
+                return parsed;
+                }));
+        }
+
+        // Merge in file order; chunk i's lines follow all lines of chunks < i
+        size_t linesBefore = 0;
+        for (future<ParsedChunk>& result : pending) {
+            ParsedChunk parsed = result.get();
+            for (size_t line : parsed.malformedLines) warnMalformedLine(linesBefore + line);
+            for (size_t i = 0; i < parsed.records.size(); ++i) sink(parsed.keys[i], std::move(parsed.records[i]));
+            linesBefore += parsed.lineCount;
+        }
+        return true;
     }
+}
+
+void setLoaderThreadCount(size_t threads) {
+    loaderThreads = threads;
+}
+
+/**
+ * @brief Collect every record of the file for structures built in one step.
+ */
+bool readCourses(const string& fileName, vector<Course>& courses) {
+    return forEachCourseInFile(fileName, [&](const CourseKey&, Course&& course) {
+        courses.push_back(std::move(course));
+        });
+}
 
-    cout << "Courses loaded successfully (HashTable)." << endl;
+/**
+ * @brief Load courses into a HashTable from a CSV-like file.
+ *        Format: COURSE_NUMBER,COURSE_TITLE[,PREREQ_1,PREREQ_2,...]
+ * @note Skips lines with missing number or title and prints a warning.
+ */
+void loadCourses(HashTable& courseTable, const string& fileName) {
+    bool opened = forEachCourseInFile(fileName, [&](const CourseKey& key, Course&& course) {
+        // Insert new Course into the HashTable
+        courseTable.Insert(key, course);
+        });
+    if (opened) cout << "Courses loaded successfully (HashTable)." << endl;
 }
 
 /**
@@ -72,43 +204,102 @@ void loadCourses(HashTable& courseTable, const string& fileName) {
  *        Format: COURSE_NUMBER,COURSE_TITLE[,PREREQ_1,PREREQ_2,...]
  */
 void loadCourses(RedBlackTree& tree, const string& fileName) {
-    ifstream file(fileName);
-    if (!file.is_open()) {
-        cout << "Error: Could not open file: " << fileName << endl;
+    if (tree.Size() == 0) {
+        // Empty tree: collect, then bulk-build without rotations
+        vector<Course> courses;
+        if (!readCourses(fileName, courses)) return;
+
+        tree.BuildFromSorted(std::move(courses));
+        cout << "Courses loaded successfully (RBT)." << endl;
         return;
     }
 
-    string line;
-    int lineNumber = 0;
-    while (getline(file, line)) {
-        ++lineNumber;
-        if (line.empty()) continue;
-
-        istringstream ss(line);
-        string courseNumber;
-        string courseName;
-        vector<string> prerequisites;
-        string token;
-
-        // Parse number and title
-        if (!getline(ss, courseNumber, ',')) continue;
-        if (!getline(ss, courseName, ',')) continue;
-
-        // Validate required fields
-        if (courseNumber.empty() || courseName.empty()) {
-            cout << "Warning: Line " << lineNumber
-                << " skipped due to incorrect formatting." << endl;
-            continue;
-        }
+    bool opened = forEachCourseInFile(fileName, [&](const CourseKey& key, Course&& course) {
+        // Insert new Course into the RedBlackTree
+        tree.Insert(key, course);
+        });
+    if (opened) cout << "Courses loaded successfully (RBT)." << endl;
+}
 
-        // Parse any remaining comma-separated values as prerequisites
-        while (getline(ss, token, ',')) {
-            if (!token.empty()) prerequisites.push_back(token);
+/**
+ * @brief Serve from the snapshot when it is valid and fresh; otherwise parse
+ *        the CSV and refresh the snapshot for the next launch.
+ */
+void loadCatalog(RedBlackTree& tree, const string& fileName) {
+    string sourceName = fileName;
+    string snapshotName = fileName + CatalogSnapshot::EXTENSION;
+    bool givenSnapshot = CatalogSnapshot::IsSnapshotFile(fileName);
+    if (givenSnapshot) {
+        snapshotName = fileName;
+        string_view extension = CatalogSnapshot::EXTENSION;
+        bool hasExtension = fileName.size() > extension.size()
+            && fileName.compare(fileName.size() - extension.size(), extension.size(), extension) == 0;
+        sourceName = hasExtension ? fileName.substr(0, fileName.size() - extension.size()) : string();
+    }
+
+    tree.Clear();
+    {
+        CatalogSnapshot snapshot;
+        if (snapshot.Open(snapshotName) && snapshot.MatchesSource(sourceName)
+            && tree.BuildFromSnapshot(snapshot)) {
+            cout << "Courses loaded successfully from snapshot (RBT)." << endl;
+            return;
         }
+    }
 
-		// Insert new Course into the RedBlackTree
-        tree.Insert(Course(courseNumber, courseName, prerequisites));
+    if (givenSnapshot) {
+        if (sourceName.empty()) {
+            cout << "Error: Snapshot " << fileName << " is out of date or damaged." << endl;
+            return;
+        }
+        cout << "Warning: Snapshot " << fileName << " is out of date or damaged; reparsing "
+            << sourceName << "." << endl;
     }
 
+    vector<Course> courses;
+    if (!readCourses(sourceName, courses)) return;
+    tree.BuildFromSorted(std::move(courses));
     cout << "Courses loaded successfully (RBT)." << endl;
+
+    if (!CatalogSnapshot::Write(snapshotName, tree, sourceName)) {
+        cout << "Warning: Continuing without a snapshot." << endl;
+    }
+}
+
+/**
+ * @brief Parse the whole file, then build the perfect-hash catalog once.
+ *        Format: COURSE_NUMBER,COURSE_TITLE[,PREREQ_1,PREREQ_2,...]
+ */
+void loadCourses(FrozenCatalog& catalog, const string& fileName) {
+    vector<Course> courses;
+    if (!readCourses(fileName, courses)) return;
+
+    catalog.Build(std::move(courses));
+    cout << "Courses loaded successfully (Frozen)." << endl;
+}
+
+/**
+ * @brief Parse the whole file, then publish it to the shards in one batch.
+ *        Format: COURSE_NUMBER,COURSE_TITLE[,PREREQ_1,PREREQ_2,...]
+ */
+void loadCourses(ConcurrentHashTable& table, const string& fileName) {
+    vector<Course> courses;
+    if (!readCourses(fileName, courses)) return;
+
+    table.InsertBatch(std::move(courses));
+    cout << "Courses loaded successfully (Concurrent HashTable)." << endl;
+}
+
+/**
+ * @brief Load courses into a CourseTrie from a CSV-like file.
+ *        Format: COURSE_NUMBER,COURSE_TITLE[,PREREQ_1,PREREQ_2,...]
+ */
+void loadCourses(CourseTrie& trie, const string& fileName) {
+    bool opened = forEachCourseInFile(fileName, [&](const CourseKey&, Course&& course) {
+        trie.Insert(course);
+        });
+    if (!opened) return;
+
+    trie.Compact();
+    cout << "Courses loaded successfully (Trie)." << endl;
 }
@@ -1,8 +1,13 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include "HashTable.h"
 #include "RedBlackTree.h"
+#include "FrozenCatalog.h"
+#include "ConcurrentHashTable.h"
+#include "CourseTrie.h"
+#include "CatalogSnapshot.h"
 
 /**
  * @file FileLoader.h
@@ -12,12 +17,34 @@
  *   COURSE_NUMBER,COURSE_TITLE[,PREREQ_1,PREREQ_2,...]
  *
  * Behavior:
+ *  - Files are memory-mapped and tokenized in place; each record's strings
+ *    are allocated once, when its Course is built. LF and CRLF line endings
+ *    are both accepted.
+ *  - Large files are split at line boundaries and parsed on several threads;
+ *    records still reach the destination in file order.
  *  - Lines with missing number or title are skipped with a warning.
  *  - Prerequisites are optional; any remaining comma-separated values on the line
  *    are treated as Course prerequisites.
  *  - No exceptions are thrown for malformed lines; loading proceeds line-by-line.
  */
 
+ /** Smallest per-thread share of a file worth parsing on its own thread. */
+constexpr size_t PARALLEL_MIN_CHUNK_BYTES = size_t(1) << 20;
+
+/**
+ * @brief Set how many threads the loaders may parse with.
+ * @param threads Thread count; 0 (the default) uses one per hardware thread.
+ */
+void setLoaderThreadCount(size_t threads);
+
+ /**
+  * @brief Parse every valid record of a file, in file order.
+  * @param fileName Path to the input file.
+  * @param courses  Receives the parsed courses (appended).
+  * @return False if the file could not be opened (an error is printed).
+  */
+bool readCourses(const std::string& fileName, std::vector<Course>& courses);
+
  /**
   * @brief Load courses into a HashTable.
   * @param courseTable Destination hash table.
@@ -26,8 +53,47 @@
 void loadCourses(HashTable& courseTable, const std::string& fileName);
 
 /**
- * @brief Load courses into a RedBlackTree.
+ * @brief Load courses into a RedBlackTree. An empty tree is bulk-built in
+ *        O(n) with BuildFromSorted; otherwise courses are inserted one by one.
  * @param tree     Destination red-black tree.
  * @param fileName Path to the input file.
  */
 void loadCourses(RedBlackTree& tree, const std::string& fileName);
+
+/**
+ * @brief Load a catalog into an empty RedBlackTree from either a CSV file or
+ *        its compiled snapshot (see CatalogSnapshot).
+ *
+ * For "catalog.csv" the snapshot "catalog.csv.snap" is used when it is valid
+ * and the CSV has not changed since it was written; otherwise the CSV is
+ * parsed and the snapshot rewritten. A snapshot path may also be given
+ * directly; if it is stale or damaged its CSV is reparsed instead.
+ * A snapshot load copies the mapped records straight into the tree's store
+ * in file order: no Course per record and no sort.
+ * @param tree     Destination red-black tree; prior contents are replaced.
+ * @param fileName Path to a CSV file or a snapshot.
+ */
+void loadCatalog(RedBlackTree& tree, const std::string& fileName);
+
+/**
+ * @brief Load courses into a FrozenCatalog, building its perfect hash once
+ *        after the whole file has been read.
+ * @param catalog  Destination catalog; prior contents are replaced.
+ * @param fileName Path to the input file.
+ */
+void loadCourses(FrozenCatalog& catalog, const std::string& fileName);
+
+/**
+ * @brief Load courses into a ConcurrentHashTable as one batch, so each shard
+ *        is copied and published once. Safe to run while readers are active.
+ * @param table    Destination table.
+ * @param fileName Path to the input file.
+ */
+void loadCourses(ConcurrentHashTable& table, const std::string& fileName);
+
+/**
+ * @brief Load courses into a CourseTrie.
+ * @param trie     Destination trie.
+ * @param fileName Path to the input file.
+ */
+void loadCourses(CourseTrie& trie, const std::string& fileName);
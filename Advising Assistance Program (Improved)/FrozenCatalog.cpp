@@ -0,0 +1,175 @@
+#include "FrozenCatalog.h"
+#include <algorithm>
+#include <iostream>
+using namespace std;
+
+namespace {
+    /** Re-mix a key hash with a pilot value. */
+    uint64_t MixPilot(uint64_t h, uint32_t pilot) {
+        uint64_t x = h ^ (static_cast<uint64_t>(pilot) * 0x9e3779b97f4a7c15ULL);
+        x ^= x >> 31;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 29;
+        return x;
+    }
+}
+
+FrozenCatalog::FrozenCatalog() {}
+
+/** @return Bucket for a key hash, taken from the high 32 bits. */
+size_t FrozenCatalog::BucketOf(uint64_t h) const {
+    return static_cast<size_t>(((h >> 32) * pilots.size()) >> 32);
+}
+
+/** @return Slot for a key hash under a (non-direct) pilot value. */
+size_t FrozenCatalog::SlotOf(uint64_t h, uint32_t pilot) const {
+    return static_cast<size_t>(MixPilot(h, pilot) % records.size());
+}
+
+/**
+ * @brief Build the minimal perfect hash and lay records out by slot.
+ *        Buckets are placed largest first while the table is still empty;
+ *        single-key buckets, which are the bulk of the tail, simply claim
+ *        the remaining free slots and record them directly.
+ */
+void FrozenCatalog::Build(vector<Course> courses) {
+    Clear();
+
+    // Last-wins de-duplication on the case-folded key
+    stable_sort(courses.begin(), courses.end(), [](const Course& a, const Course& b) {
+        return CompareCourseKeys(a.number, b.number) < 0;
+        });
+    vector<Course> unique;
+    unique.reserve(courses.size());
+    for (size_t i = 0; i < courses.size(); ++i) {
+        bool lastOfRun = (i + 1 == courses.size())
+            || CompareCourseKeys(courses[i].number, courses[i + 1].number) != 0;
+        if (lastOfRun) unique.push_back(std::move(courses[i]));
+    }
+
+    size_t n = unique.size();
+    if (n == 0) return;
+
+    vector<uint64_t> hashes(n);
+    for (size_t i = 0; i < n; ++i) hashes[i] = HashCourseKey(unique[i].number);
+
+    pilots.assign((n + KEYS_PER_BUCKET - 1) / KEYS_PER_BUCKET, 0);
+    records.resize(n);
+
+    // Group key indices by bucket (counting sort)
+    size_t bucketCount = pilots.size();
+    vector<size_t> bucketStart(bucketCount + 1, 0);
+    for (size_t i = 0; i < n; ++i) ++bucketStart[BucketOf(hashes[i]) + 1];
+    for (size_t b = 0; b < bucketCount; ++b) bucketStart[b + 1] += bucketStart[b];
+    vector<size_t> bucketKeys(n);
+    {
+        vector<size_t> fill(bucketStart.begin(), bucketStart.end() - 1);
+        for (size_t i = 0; i < n; ++i) bucketKeys[fill[BucketOf(hashes[i])]++] = i;
+    }
+
+    vector<size_t> order(bucketCount);
+    for (size_t b = 0; b < bucketCount; ++b) order[b] = b;
+    stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return bucketStart[a + 1] - bucketStart[a] > bucketStart[b + 1] - bucketStart[b];
+        });
+
+    vector<bool> taken(n, false);
+    vector<size_t> slots;
+    size_t nextFree = 0;
+    vector<size_t> slotOwner(n, 0);
+
+    for (size_t b : order) {
+        size_t begin = bucketStart[b];
+        size_t end = bucketStart[b + 1];
+        if (begin == end) break; // remaining buckets are empty
+
+        if (end - begin == 1) {
+            while (taken[nextFree]) ++nextFree;
+            taken[nextFree] = true;
+            slotOwner[nextFree] = bucketKeys[begin];
+            pilots[b] = DIRECT_SLOT | static_cast<uint32_t>(nextFree);
+            continue;
+        }
+
+        bool placed = false;
+        for (uint32_t pilot = 0; pilot < MAX_PILOT_TRIES && !placed; ++pilot) {
+            slots.clear();
+            bool ok = true;
+            for (size_t k = begin; k < end && ok; ++k) {
+                size_t slot = SlotOf(hashes[bucketKeys[k]], pilot);
+                ok = !taken[slot] && find(slots.begin(), slots.end(), slot) == slots.end();
+                slots.push_back(slot);
+            }
+            if (!ok) continue;
+
+            for (size_t k = begin; k < end; ++k) {
+                taken[slots[k - begin]] = true;
+                slotOwner[slots[k - begin]] = bucketKeys[k];
+            }
+            pilots[b] = pilot;
+            placed = true;
+        }
+
+        if (!placed) {
+            cout << "Error: Could not build perfect hash for catalog." << endl;
+            Clear();
+            return;
+        }
+    }
+
+    // Lay records out densely in slot order
+    fingerprints.resize(n);
+    for (size_t slot = 0; slot < n; ++slot) {
+        size_t i = slotOwner[slot];
+        fingerprints[slot] = static_cast<uint32_t>(hashes[i]);
+        records[slot] = std::move(unique[i]);
+    }
+}
+
+void FrozenCatalog::Build(const HashTable& table) {
+    vector<Course> courses;
+    courses.reserve(table.Size());
+    table.ForEach([&](const CourseView& c) { courses.push_back(c.ToCourse()); });
+    Build(std::move(courses));
+}
+
+void FrozenCatalog::Build(const RedBlackTree& tree) {
+    vector<Course> courses;
+    tree.ForEach([&](const CourseView& c) { courses.push_back(c.ToCourse()); });
+    Build(std::move(courses));
+}
+
+/**
+ * @brief One probe per lookup: bucket -> pilot -> slot, then fingerprint and
+ *        key comparison.
+ */
+const Course* FrozenCatalog::Find(string_view courseNumber) const {
+    if (records.empty()) return nullptr;
+
+    uint64_t h = HashCourseKey(courseNumber);
+    uint32_t pilot = pilots[BucketOf(h)];
+    size_t slot = (pilot & DIRECT_SLOT) ? (pilot & ~DIRECT_SLOT) : SlotOf(h, pilot);
+
+    if (fingerprints[slot] != static_cast<uint32_t>(h)) return nullptr;
+    if (!CourseKeyEquals(records[slot].number, courseNumber)) return nullptr;
+    return &records[slot];
+}
+
+Course FrozenCatalog::Search(string courseNumber) const {
+    const Course* found = Find(courseNumber);
+    return found ? *found : Course();
+}
+
+void FrozenCatalog::ForEach(const function<void(const Course&)>& fn) const {
+    for (const Course& c : records) fn(c);
+}
+
+size_t FrozenCatalog::Size() const {
+    return records.size();
+}
+
+void FrozenCatalog::Clear() {
+    pilots.clear();
+    fingerprints.clear();
+    records.clear();
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <functional>
+#include "Course.h"
+#include "HashTable.h"
+#include "RedBlackTree.h"
+
+/**
+ * @file FrozenCatalog.h
+ * @brief Read-only course index built once over a minimal perfect hash.
+ *
+ * The catalog only changes between term updates, so this index trades
+ * mutability for lookup speed. Build() computes a minimal perfect hash
+ * (hash-and-displace: keys are grouped into small buckets and each bucket
+ * gets a "pilot" value that sends all of its keys to distinct free slots)
+ * over the case-folded Course::number keys. Records are stored densely in
+ * slot order, next to a 32-bit fingerprint of each key's hash.
+ *
+ * A lookup is exactly one slot probe: hash the key, read its bucket's pilot,
+ * compute the slot, compare fingerprints and only then the key string. Most
+ * misses are rejected by the fingerprint without touching the record.
+ */
+class FrozenCatalog {
+public:
+    FrozenCatalog();
+
+    /**
+     * @brief Build the index from a list of courses, replacing any prior
+     *        contents. Duplicate keys (case-insensitive) resolve last-wins.
+     * @param courses Records to index; consumed by the build.
+     */
+    void Build(std::vector<Course> courses);
+
+    /** @brief Build from every course currently stored in a HashTable. */
+    void Build(const HashTable& table);
+
+    /** @brief Build from every course currently stored in a RedBlackTree. */
+    void Build(const RedBlackTree& tree);
+
+    /**
+     * @brief Zero-copy lookup by catalog number (case-insensitive).
+     * @return Pointer to the stored Course, or nullptr if not found.
+     */
+    const Course* Find(std::string_view courseNumber) const;
+
+    /**
+     * @brief Lookup returning a copy, mirroring HashTable/RedBlackTree::Search.
+     * @return Matching Course, or a default-constructed Course if not found.
+     */
+    Course Search(std::string courseNumber) const;
+
+    /**
+     * @brief Apply a function to each stored course in slot order (unsorted).
+     */
+    void ForEach(const std::function<void(const Course&)>& fn) const;
+
+    /** @return Number of stored courses. */
+    size_t Size() const;
+
+    /** @brief Remove all records and the hash function. */
+    void Clear();
+
+private:
+    std::vector<uint32_t> pilots;       // one per bucket; DIRECT_SLOT marks a stored slot index
+    std::vector<uint32_t> fingerprints; // low 32 bits of each slot's key hash
+    std::vector<Course> records;        // dense, indexed by slot
+
+    /** Flag on a pilot meaning "the low bits are the slot itself". */
+    static constexpr uint32_t DIRECT_SLOT = 0x80000000u;
+
+    /** Average number of keys per bucket. */
+    static constexpr size_t KEYS_PER_BUCKET = 4;
+
+    /** Give up on a bucket after this many pilot values. */
+    static constexpr uint32_t MAX_PILOT_TRIES = 1u << 22;
+
+    size_t BucketOf(uint64_t h) const;
+    size_t SlotOf(uint64_t h, uint32_t pilot) const;
+};
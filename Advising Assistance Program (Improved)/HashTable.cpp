@@ -1,52 +1,287 @@
 #include "HashTable.h"
+#include "Prefetch.h"
 #include <algorithm>
-#include <cctype>
 #include <iostream>
 #include <functional>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define HASHTABLE_SSE2 1
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 using namespace std;
 
+namespace {
+    /** Smallest bucket array we ever allocate (one full control group). */
+    constexpr unsigned int MIN_BUCKETS = 16;
+
+    /** Round up to the next power of two (minimum MIN_BUCKETS). */
+    unsigned int RoundUpPow2(unsigned int n) {
+        unsigned int p = MIN_BUCKETS;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    /** 7-bit tag stored in a full bucket's control byte. */
+    int8_t TagOf(uint64_t h) {
+        return static_cast<int8_t>(h >> 57);
+    }
+
+    /**
+     * Bitmask of the bytes in a 16-byte control group equal to `value`
+     * (bit i set means group[i] == value).
+     */
+    uint32_t MatchByte(const int8_t* group, int8_t value) {
+#ifdef HASHTABLE_SSE2
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(value))));
+#else
+        uint32_t mask = 0;
+        for (unsigned int i = 0; i < 16; ++i) {
+            if (group[i] == value) mask |= 1u << i;
+        }
+        return mask;
+#endif
+    }
+
+    /** Index of the lowest set bit; mask must be non-zero. */
+    unsigned int LowestBit(uint32_t mask) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return static_cast<unsigned int>(index);
+#else
+        return static_cast<unsigned int>(__builtin_ctz(mask));
+#endif
+    }
+}
+
 /**
  * @brief Construct a hash table with a given number of buckets.
- * @param size Number of buckets to allocate.
+ * @param size        Number of buckets to allocate (rounded up to a power of two).
+ * @param incremental Whether growth should migrate entries gradually.
  */
-HashTable::HashTable(unsigned int size) {
-    tableSize = size;
-    table.resize(tableSize);
-    occupied.resize(tableSize, false);
+HashTable::HashTable(unsigned int size, bool incremental) {
+    static_assert(GROUP_WIDTH == 16, "MatchByte scans 16-byte control groups");
+    tableSize = RoundUpPow2(size);
+    count = 0;
+    ResetArrays(table, ctrl, hashes, tableSize);
+
+    incrementalRehash = incremental;
+    oldTableSize = 0;
+    migrateIndex = 0;
+}
+
+/**
+ * @brief Compute a 64-bit hash for a packed key.
+ * @param key Packed Course catalog number.
+ * @return Mixed hash value (see CourseKey::Hash).
+ */
+uint64_t HashTable::hash(const CourseKey& key) {
+    return key.Hash();
+}
+
+/**
+ * @brief Size a bucket array and mark every control byte EMPTY, including the
+ *        GROUP_WIDTH mirror bytes past the end.
+ */
+void HashTable::ResetArrays(vector<uint32_t>& slots, vector<int8_t>& ctrlBytes,
+    vector<uint32_t>& hashBits, unsigned int size) {
+    slots.assign(size, 0);
+    ctrlBytes.assign(size + GROUP_WIDTH, CTRL_EMPTY);
+    hashBits.assign(size, 0);
 }
 
 /**
- * @brief Compute a simple hash value for a string key.
- * @param key Input string (typically a Course catalog number).
- * @return Index in the range [0, tableSize).
+ * @brief Set a control byte; the first GROUP_WIDTH buckets are mirrored past
+ *        the end of the array.
  */
-unsigned int HashTable::hash(string key) {
-    int sum = 0;
-    for (char ch : key) {
-        sum += static_cast<int>(ch);
+void HashTable::SetCtrl(unsigned int index, int8_t value) {
+    ctrl[index] = value;
+    if (index < GROUP_WIDTH) ctrl[tableSize + index] = value;
+}
+
+/**
+ * @brief Probe one bucket array a control group at a time. Robin Hood
+ *        placement and backward-shift deletion keep every key before the first
+ *        EMPTY bucket after its home, so tag matches beyond it are ignored and
+ *        the probe stops there.
+ * @return Bucket index of the key, or -1 if absent.
+ */
+long long HashTable::FindSlot(const vector<uint32_t>& slots, const vector<int8_t>& ctrlBytes,
+    unsigned int size, const CourseKey& key, string_view text, uint64_t h) const {
+    unsigned int mask = size - 1;
+    unsigned int pos = static_cast<unsigned int>(h) & mask;
+    int8_t tag = TagOf(h);
+
+    while (true) {
+        const int8_t* group = &ctrlBytes[pos];
+        uint32_t matches = MatchByte(group, tag);
+        uint32_t empties = MatchByte(group, CTRL_EMPTY);
+        if (empties) matches &= (1u << LowestBit(empties)) - 1;
+
+        // Packed key comparisons only on tag matches
+        while (matches) {
+            unsigned int index = (pos + LowestBit(matches)) & mask;
+            uint32_t record = slots[index];
+            if (store.Key(record) == key
+                && (key.IsInline() || CourseKey::CompareTails(store.Number(record), text) == 0)) {
+                return index;
+            }
+            matches &= matches - 1;
+        }
+        if (empties) return -1;
+        pos = (pos + GROUP_WIDTH) & mask;
     }
-    return sum % tableSize;
 }
 
 /**
- * @brief Insert a new course into the table.
- *        Uses linear probing to resolve collisions.
- * @param course The Course object to insert.
+ * @brief Robin Hood placement: walk from the home bucket and, whenever the
+ *        resident sits closer to its own home than the carried entry does,
+ *        swap them and keep going with the displaced resident. The caller
+ *        guarantees there is a free bucket and that the key is not present.
  */
-void HashTable::Insert(Course course) {
-    unsigned int key = hash(course.number);
-    unsigned int originalKey = key;
+void HashTable::InsertSlot(uint32_t record, uint32_t hashLow, int8_t tag) {
+    unsigned int mask = tableSize - 1;
+    unsigned int pos = hashLow & mask;
+    unsigned int dist = 0;
+
+    uint32_t carried = record;
+    while (ctrl[pos] != CTRL_EMPTY) {
+        unsigned int residentDist = (pos - (hashes[pos] & mask)) & mask;
+        if (residentDist < dist) {
+            swap(carried, table[pos]);
+            swap(hashLow, hashes[pos]);
+            int8_t residentTag = ctrl[pos];
+            SetCtrl(pos, tag);
+            tag = residentTag;
+            dist = residentDist;
+        }
+        pos = (pos + 1) & mask;
+        ++dist;
+    }
+
+    table[pos] = carried;
+    hashes[pos] = hashLow;
+    SetCtrl(pos, tag);
+}
 
-    while (occupied[key]) {
-        key = (key + 1) % tableSize;
-        if (key == originalKey) {
-            cout << "Error: Hash table is full." << endl;
+/**
+ * @brief Double the capacity. Without incremental rehashing every entry is
+ *        moved immediately; otherwise the current array becomes the "old"
+ *        array and is drained by subsequent Inserts.
+ */
+void HashTable::Grow() {
+    if (!incrementalRehash) {
+        Resize(tableSize * 2);
+        return;
+    }
+
+    // Never keep more than one old generation around
+    if (Migrating()) MigrateSome(oldTableSize);
+
+    oldTable.swap(table);
+    oldCtrl.swap(ctrl);
+    oldHashes.swap(hashes);
+    oldTableSize = tableSize;
+    migrateIndex = 0;
+
+    tableSize *= 2;
+    ResetArrays(table, ctrl, hashes, tableSize);
+}
+
+/**
+ * @brief Migrate up to `steps` buckets from the old array. Once the whole old
+ *        array has been visited its storage is released.
+ */
+void HashTable::MigrateSome(unsigned int steps) {
+    while (steps-- > 0 && migrateIndex < oldTableSize) {
+        if (oldCtrl[migrateIndex] != CTRL_EMPTY) {
+            InsertSlot(oldTable[migrateIndex], oldHashes[migrateIndex], oldCtrl[migrateIndex]);
+        }
+        ++migrateIndex;
+    }
+    if (migrateIndex >= oldTableSize) {
+        vector<uint32_t>().swap(oldTable);
+        vector<int8_t>().swap(oldCtrl);
+        vector<uint32_t>().swap(oldHashes);
+        oldTableSize = 0;
+        migrateIndex = 0;
+    }
+}
+
+/**
+ * @brief Insert a course into the table, or replace the stored course with
+ *        the same key. Grows the table before the load factor would be exceeded.
+ * @param course The Course object to upsert.
+ */
+void HashTable::Insert(const Course& course) {
+    Insert(CourseKey(course.number), course);
+}
+
+void HashTable::Insert(const CourseKey& key, const Course& course) {
+    if (Migrating()) MigrateSome(REHASH_STEPS);
+
+    // Upsert: overwrite the record wherever the key currently lives
+    uint64_t h = hash(key);
+    long long slot = FindSlot(table, ctrl, tableSize, key, course.number, h);
+    if (slot >= 0) {
+        store.Replace(table[slot], course);
+        return;
+    }
+    if (Migrating()) {
+        slot = FindSlot(oldTable, oldCtrl, oldTableSize, key, course.number, h);
+        if (slot >= 0) {
+            store.Replace(oldTable[slot], course);
             return;
         }
     }
 
-    table[key] = course;
-    occupied[key] = true;
+    if (static_cast<double>(count + 1) > LOAD_FACTOR * tableSize) {
+        Grow();
+        if (Migrating()) MigrateSome(REHASH_STEPS);
+    }
+
+    InsertSlot(store.Add(key, course), static_cast<uint32_t>(h), TagOf(h));
+    ++count;
+}
+
+/**
+ * @brief Remove a course and close the gap with backward-shift deletion:
+ *        each following entry that is not in its home bucket moves back one
+ *        slot until an EMPTY bucket or an entry at distance zero is reached.
+ * @param courseNumber The course key to remove (case-insensitive).
+ * @return True if the course was present.
+ */
+bool HashTable::Erase(string_view courseNumber) {
+    // Shifting inside a half-drained old array could move entries behind the
+    // migration cursor, so finish the migration first
+    if (Migrating()) MigrateSome(oldTableSize);
+
+    CourseKey key(courseNumber);
+    long long slot = FindSlot(table, ctrl, tableSize, key, courseNumber, hash(key));
+    if (slot < 0) return false;
+    store.Remove(table[slot]);
+
+    unsigned int mask = tableSize - 1;
+    unsigned int hole = static_cast<unsigned int>(slot);
+    while (true) {
+        unsigned int next = (hole + 1) & mask;
+        if (ctrl[next] == CTRL_EMPTY || ((next - (hashes[next] & mask)) & mask) == 0) break;
+
+        table[hole] = table[next];
+        hashes[hole] = hashes[next];
+        SetCtrl(hole, ctrl[next]);
+        hole = next;
+    }
+
+    table[hole] = 0;
+    hashes[hole] = 0;
+    SetCtrl(hole, CTRL_EMPTY);
+    --count;
+    return true;
 }
 
 /**
@@ -54,56 +289,145 @@ void HashTable::Insert(Course course) {
  * @param courseNumber The course key to find (case-insensitive).
  * @return Matching Course if found, otherwise a default-constructed Course.
  */
-Course HashTable::Search(string courseNumber) {
-    transform(courseNumber.begin(), courseNumber.end(), courseNumber.begin(), ::toupper);
+Course HashTable::Search(string courseNumber) const {
+    CourseView found = Find(courseNumber);
+    return found ? found.ToCourse() : Course();
+}
+
+/**
+ * @brief Locate a course without copying it or the key.
+ * @param courseNumber The course key to find (case-insensitive).
+ * @return View into the store, or an empty view if not found.
+ */
+CourseView HashTable::Find(string_view courseNumber) const {
+    CourseKey key(courseNumber);
+    uint64_t h = hash(key);
 
-    unsigned int key = hash(courseNumber);
-    unsigned int originalKey = key;
+    long long slot = FindSlot(table, ctrl, tableSize, key, courseNumber, h);
+    if (slot >= 0) return store.View(table[slot]);
 
-    while (occupied[key]) {
-        if (table[key].number == courseNumber) {
-            return table[key];
+    // Entries not yet migrated still live in the old array
+    if (Migrating()) {
+        slot = FindSlot(oldTable, oldCtrl, oldTableSize, key, courseNumber, h);
+        if (slot >= 0) return store.View(oldTable[slot]);
+    }
+    return CourseView();
+}
+
+/**
+ * @brief Look up many keys, prefetching each group's home buckets (control
+ *        group and record ID) before probing any of them.
+ */
+void HashTable::SearchMany(const vector<string_view>& keys, vector<CourseView>& out) const {
+    out.assign(keys.size(), CourseView());
+    unsigned int mask = tableSize - 1;
+    CourseKey groupKeys[BATCH_WIDTH];
+    uint64_t groupHashes[BATCH_WIDTH];
+
+    for (size_t base = 0; base < keys.size(); base += BATCH_WIDTH) {
+        size_t groupSize = min(BATCH_WIDTH, keys.size() - base);
+
+        // Stage 1: hash and prefetch
+        for (size_t i = 0; i < groupSize; ++i) {
+            groupKeys[i] = CourseKey(keys[base + i]);
+            groupHashes[i] = hash(groupKeys[i]);
+            unsigned int home = static_cast<unsigned int>(groupHashes[i]) & mask;
+            PrefetchRead(&ctrl[home]);
+            PrefetchRead(&table[home]);
+        }
+
+        // Stage 2: probe, by now mostly from cache
+        for (size_t i = 0; i < groupSize; ++i) {
+            long long slot = FindSlot(table, ctrl, tableSize, groupKeys[i], keys[base + i], groupHashes[i]);
+            if (slot >= 0) {
+                out[base + i] = store.View(table[slot]);
+            }
+            else if (Migrating()) {
+                slot = FindSlot(oldTable, oldCtrl, oldTableSize, groupKeys[i], keys[base + i], groupHashes[i]);
+                if (slot >= 0) out[base + i] = store.View(oldTable[slot]);
+            }
         }
-        key = (key + 1) % tableSize;
-        if (key == originalKey) break;
     }
-    return Course();
 }
 
 /**
- * @brief Print all courses in sorted order by course number.
+ * @brief Print all courses in sorted order by course number. Only the 4-byte
+ *        record IDs are sorted; no Course is copied.
  */
 void HashTable::PrintAll() {
-    vector<Course> courses;
+    vector<uint32_t> records;
+    records.reserve(count);
     for (unsigned int i = 0; i < tableSize; ++i) {
-        if (occupied[i]) courses.push_back(table[i]);
+        if (ctrl[i] != CTRL_EMPTY) records.push_back(table[i]);
     }
-    sort(courses.begin(), courses.end());
-    for (const auto& c : courses) {
+    for (unsigned int i = migrateIndex; i < oldTableSize; ++i) {
+        if (oldCtrl[i] != CTRL_EMPTY) records.push_back(oldTable[i]);
+    }
+
+    // Same order as operator< on Course: raw (case-sensitive) numbers
+    sort(records.begin(), records.end(), [&](uint32_t a, uint32_t b) {
+        return store.Number(a) < store.Number(b);
+        });
+    for (uint32_t record : records) {
+        CourseView c = store.View(record);
         cout << c.number << ", " << c.title << endl;
     }
 }
 
 /**
- * @brief Resize the table to a new bucket count.
- *        Clears the table and resets occupancy flags.
- * @param newSize The new bucket count.
+ * @brief Resize the table to a new bucket count and rehash every live entry,
+ *        including any still waiting in the old array.
+ * @param newSize The requested bucket count.
  */
 void HashTable::Resize(unsigned int newSize) {
-    tableSize = newSize;
-    table.clear();
-    occupied.clear();
-    table.resize(tableSize);
-    occupied.resize(tableSize, false);
+    unsigned int required = static_cast<unsigned int>(count / LOAD_FACTOR) + 1;
+    unsigned int target = RoundUpPow2(max(newSize, required));
+
+    vector<uint32_t> prevTable;
+    vector<int8_t> prevCtrl;
+    vector<uint32_t> prevHashes;
+    prevTable.swap(table);
+    prevCtrl.swap(ctrl);
+    prevHashes.swap(hashes);
+    unsigned int prevSize = tableSize;
+
+    tableSize = target;
+    ResetArrays(table, ctrl, hashes, tableSize);
+
+    for (unsigned int i = 0; i < prevSize; ++i) {
+        if (prevCtrl[i] == CTRL_EMPTY) continue;
+        InsertSlot(prevTable[i], prevHashes[i], prevCtrl[i]);
+    }
+    for (unsigned int i = migrateIndex; i < oldTableSize; ++i) {
+        if (oldCtrl[i] == CTRL_EMPTY) continue;
+        InsertSlot(oldTable[i], oldHashes[i], oldCtrl[i]);
+    }
+    vector<uint32_t>().swap(oldTable);
+    vector<int8_t>().swap(oldCtrl);
+    vector<uint32_t>().swap(oldHashes);
+    oldTableSize = 0;
+    migrateIndex = 0;
 }
 
 /**
- * @brief Apply a function to each stored Course.
+ * @brief Switch incremental rehashing on or off for future growth.
+ *        Turning it off drains any pending migration immediately.
+ */
+void HashTable::SetIncrementalRehash(bool enabled) {
+    incrementalRehash = enabled;
+    if (!enabled && Migrating()) MigrateSome(oldTableSize);
+}
+
+/**
+ * @brief Apply a function to a view of each stored course.
  * @param fn Function to invoke for every occupied slot.
  */
-void HashTable::ForEach(const function<void(const Course&)>& fn) const {
+void HashTable::ForEach(const function<void(const CourseView&)>& fn) const {
     for (unsigned int i = 0; i < tableSize; ++i) {
-        if (occupied[i]) fn(table[i]);
+        if (ctrl[i] != CTRL_EMPTY) fn(store.View(table[i]));
+    }
+    for (unsigned int i = migrateIndex; i < oldTableSize; ++i) {
+        if (oldCtrl[i] != CTRL_EMPTY) fn(store.View(oldTable[i]));
     }
 }
 
@@ -112,9 +436,14 @@ size_t HashTable::Capacity() const {
     return static_cast<size_t>(tableSize);
 }
 
-/** @return The number of occupied buckets. */
+/** @return The number of stored courses. */
 size_t HashTable::Size() const {
-    size_t n = 0;
-    for (unsigned int i = 0; i < tableSize; ++i) if (occupied[i]) ++n;
-    return n;
+    return count;
+}
+
+size_t HashTable::MemoryBytes() const {
+    return store.MemoryBytes()
+        + (table.capacity() + oldTable.capacity()) * sizeof(uint32_t)
+        + (ctrl.capacity() + oldCtrl.capacity()) * sizeof(int8_t)
+        + (hashes.capacity() + oldHashes.capacity()) * sizeof(uint32_t);
 }
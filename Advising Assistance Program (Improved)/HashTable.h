@@ -1,75 +1,207 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <functional>
 #include "Course.h"
+#include "CatalogStore.h"
+#include "CourseKey.h"
 
 /**
  * @file HashTable.h
- * @brief Open-addressed hash table keyed by Course::number (linear probing).
+ * @brief Open-addressed hash table keyed by Course::number (Robin Hood probing).
  *
- * This container stores Course values directly. Collisions are resolved via
- * linear probing. Keys are the Course catalog identifiers (e.g., "CS101"),
- * taken from Course::number.
+ * Course records live in a CatalogStore owned by the table; each bucket holds
+ * only the record's 32-bit ID, and lookups hand back a CourseView into the
+ * store instead of a Course copy. Keys are hashed and compared as packed
+ * CourseKeys, so a probe never reads the stored number text (except to break
+ * a tie between two keys longer than CourseKey::INLINE_BYTES). Collisions are resolved via
+ * linear probing over a power-of-two bucket array with Robin Hood placement:
+ * an inserted entry takes the bucket of any resident that sits closer to its
+ * own home, which keeps probe lengths uniformly short. Keys are the Course
+ * catalog identifiers (e.g., "CS101"), taken from Course::number, and are
+ * unique: inserting an existing key replaces the stored Course. Erase uses
+ * backward-shift deletion, so no tombstones are ever left behind.
+ *
+ * Occupancy lives in a separate control-byte array (Swiss-table style): each
+ * bucket has one byte that is either EMPTY or a 7-bit tag taken from the top of
+ * the key's hash. Probes compare GROUP_WIDTH control bytes at once (SSE2 when
+ * available) and only touch a stored key when its tag matches, so a miss usually
+ * costs a single 16-byte load and never a string comparison.
+ *
+ * The table grows automatically (doubling) once the number of stored entries
+ * would exceed LOAD_FACTOR * capacity, so probe sequences stay short no matter
+ * how large the catalog gets. By default growth rehashes every entry at once;
+ * with incremental rehashing enabled the old bucket array is kept alongside the
+ * new one and drained a few buckets per Insert, bounding the worst-case insert
+ * latency at the cost of a second probe during migration.
  */
 class HashTable {
 private:
-    // Parallel arrays for payload and occupancy flags
-    std::vector<Course> table;
-    std::vector<bool> occupied;
+    // Parallel arrays for record IDs, control bytes and the low 32 hash bits
+    // of each entry (used to compute probe distances and to rehash without
+    // rehashing strings). The control array holds tableSize + GROUP_WIDTH
+    // bytes; the tail mirrors the first GROUP_WIDTH buckets so a group load
+    // starting near the end never wraps.
+    CatalogStore store;
+    std::vector<uint32_t> table;
+    std::vector<int8_t> ctrl;
+    std::vector<uint32_t> hashes;
     unsigned int tableSize;
+    size_t count;
+
+    // Incremental rehash state: the previous bucket array while it is drained
+    bool incrementalRehash;
+    std::vector<uint32_t> oldTable;
+    std::vector<int8_t> oldCtrl;
+    std::vector<uint32_t> oldHashes;
+    unsigned int oldTableSize;
+    unsigned int migrateIndex;
+
+    /** Control byte marking a free bucket; full buckets hold a tag in [0, 127]. */
+    static constexpr int8_t CTRL_EMPTY = -128;
+
+    /** Number of control bytes examined per probe step. */
+    static constexpr unsigned int GROUP_WIDTH = 16;
+
+    /**
+     * @brief Compute a well-mixed 64-bit hash for a packed key. Keys are
+     *        folded to uppercase when packed, so lookups are case-insensitive.
+     * @param key Packed catalog key.
+     * @return Hash value; callers mask it down to a bucket index.
+     */
+    static uint64_t hash(const CourseKey& key);
+
+    /**
+     * @brief Locate the bucket holding `key` in one bucket array.
+     * @param text The key's original text, read only for oversized keys.
+     * @return Bucket index, or -1 if the key is not present.
+     */
+    long long FindSlot(const std::vector<uint32_t>& slots, const std::vector<int8_t>& ctrlBytes,
+        unsigned int size, const CourseKey& key, std::string_view text, uint64_t h) const;
 
     /**
-     * @brief Compute hash for a string key.
-     * @param key Catalog key.
-     * @return Bucket index in [0, tableSize).
+     * @brief Robin Hood insert into the current bucket array without growth
+     *        or duplicate checks.
+     * @param record  Store ID of the entry.
+     * @param hashLow Low 32 bits of the key hash.
+     * @param tag     Control byte tag for the key.
      */
-    unsigned int hash(std::string key);
+    void InsertSlot(uint32_t record, uint32_t hashLow, int8_t tag);
+
+    /** Write a control byte, keeping the mirrored tail in sync. */
+    void SetCtrl(unsigned int index, int8_t value);
+
+    /** Allocate an empty bucket array of the given size. */
+    static void ResetArrays(std::vector<uint32_t>& slots, std::vector<int8_t>& ctrlBytes,
+        std::vector<uint32_t>& hashBits, unsigned int size);
+
+    /** Double the bucket array, rehashing now or scheduling a migration. */
+    void Grow();
+
+    /** Move up to `steps` buckets from the old array into the current one. */
+    void MigrateSome(unsigned int steps);
+
+    /** @return True while an incremental migration is still in progress. */
+    bool Migrating() const { return oldTableSize != 0; }
 
 public:
     /**
      * @brief Construct a table with an initial bucket count.
-     * @param size Number of buckets to allocate.
+     * @param size        Number of buckets to allocate (rounded up to a power of two).
+     * @param incremental If true, growth migrates entries gradually across Inserts.
      */
-    HashTable(unsigned int size);
+    HashTable(unsigned int size, bool incremental = false);
 
     /** Maximum desired load factor before growing. */
     static constexpr double LOAD_FACTOR = 0.7;
 
+    /** Buckets migrated from the old array per Insert during incremental rehash. */
+    static constexpr unsigned int REHASH_STEPS = 8;
+
     /**
-     * @brief Insert or update a Course in the table.
-     * @param course Course value to upsert; the key is course.number.
+     * @brief Insert or update a Course, growing the table if needed.
+     *        An existing entry with the same key (case-insensitive) is replaced.
+     * @param course Course value to upsert (copied into the store); the key is course.number.
      */
-    void Insert(Course course);
+    void Insert(const Course& course);
 
     /**
-     * @brief Lookup a course by catalog number.
+     * @brief Insert with the key already packed, e.g. by the loader while the
+     *        number token is in cache. `key` must be CourseKey(course.number).
+     */
+    void Insert(const CourseKey& key, const Course& course);
+
+    /**
+     * @brief Remove a course by catalog number (case-insensitive).
+     *        Later entries of the cluster are shifted back one bucket, so the
+     *        table stays tombstone-free. Finishes any pending migration first.
+     * @param courseNumber Catalog key to remove.
+     * @return True if a course was removed.
+     */
+    bool Erase(std::string_view courseNumber);
+
+    /**
+     * @brief Lookup a course by catalog number (case-insensitive).
+     * @param courseNumber Catalog key to find.
+     * @return Owning copy of the match, or a default-constructed Course if not found.
+     */
+    Course Search(std::string courseNumber) const;
+
+    /**
+     * @brief Zero-copy lookup by catalog number (case-insensitive).
+     *        Performs no allocation; the key is compared in place.
      * @param courseNumber Catalog key to find.
-     * @return Matching Course, or a default-constructed Course if not found.
+     * @return View of the stored course, or an empty (false) view if not
+     *         found. The view is invalidated by the next Insert or Erase.
      */
-    Course Search(std::string courseNumber);
+    CourseView Find(std::string_view courseNumber) const;
 
     /**
-     * @brief Print all present courses in storage order (not sorted).
+     * @brief Batched zero-copy lookup. Keys are processed in groups of
+     *        BATCH_WIDTH: all of a group's hashes are computed and their home
+     *        buckets prefetched before any of them is probed, so the cache
+     *        misses overlap instead of running back to back.
+     * @param keys Catalog keys to find (case-insensitive).
+     * @param out  Resized to keys.size(); out[i] is the match for keys[i] or an empty view.
+     */
+    void SearchMany(const std::vector<std::string_view>& keys, std::vector<CourseView>& out) const;
+
+    /** Number of keys whose probes are interleaved by SearchMany. */
+    static constexpr size_t BATCH_WIDTH = 16;
+
+    /**
+     * @brief Print all present courses sorted by course number.
      */
     void PrintAll();
 
     /**
      * @brief Resize the table to a new bucket count and rehash entries.
+     *        The bucket count is never reduced below what LOAD_FACTOR requires.
      * @param newSize New number of buckets.
      */
     void Resize(unsigned int newSize);
 
+    /**
+     * @brief Enable or disable incremental rehashing on future growth.
+     *        Disabling it finishes any migration in progress.
+     */
+    void SetIncrementalRehash(bool enabled);
+
     /**
      * @brief Apply a function to each stored course.
      * @param fn Function to apply to each occupied slot.
      */
-    void ForEach(const std::function<void(const Course&)>& fn) const;
+    void ForEach(const std::function<void(const CourseView&)>& fn) const;
 
     /** @return Current capacity (bucket count). */
     size_t Capacity() const;
 
-    /** @return Current number of occupied buckets. */
+    /** @return Current number of stored courses. */
     size_t Size() const;
+
+    /** @return Bytes held by the bucket arrays and the record store (capacity). */
+    size_t MemoryBytes() const;
 };
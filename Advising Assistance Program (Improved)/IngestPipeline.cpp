@@ -0,0 +1,78 @@
+#include "IngestPipeline.h"
+#include "FileLoader.h"
+#include <chrono>
+#include <utility>
+using namespace std;
+
+bool IngestPipeline::Parse(const string& fileName, CourseBatch& batch) {
+    batch.sourceName = fileName;
+    batch.records.clear();
+    auto startTime = chrono::high_resolution_clock::now();
+    bool opened = readCourses(fileName, batch.records);
+    auto endTime = chrono::high_resolution_clock::now();
+    batch.parseMs = chrono::duration_cast<chrono::milliseconds>(endTime - startTime).count();
+    return opened;
+}
+
+// --- Sinks ---
+void IngestPipeline::AddSink(string name, Sink sink) {
+    sinks.emplace_back(std::move(name), std::move(sink));
+}
+
+void IngestPipeline::AddSink(HashTable& table) {
+    AddSink("HashTable", [&table](const vector<Course>& records) {
+        for (const Course& course : records) table.Insert(course);
+        });
+}
+
+void IngestPipeline::AddSink(RedBlackTree& tree) {
+    AddSink("RedBlackTree", [&tree](const vector<Course>& records) {
+        if (tree.Size() == 0) {
+            tree.BuildFromSorted(records);
+            return;
+        }
+        for (const Course& course : records) tree.Insert(course);
+        });
+}
+
+void IngestPipeline::AddSink(FrozenCatalog& catalog) {
+    AddSink("FrozenCatalog", [&catalog](const vector<Course>& records) {
+        catalog.Build(records);
+        });
+}
+
+void IngestPipeline::AddSink(ConcurrentHashTable& table) {
+    AddSink("ConcurrentHashTable", [&table](const vector<Course>& records) {
+        table.InsertBatch(records);
+        });
+}
+
+void IngestPipeline::AddSink(CourseTrie& trie) {
+    AddSink("CourseTrie", [&trie](const vector<Course>& records) {
+        for (const Course& course : records) trie.Insert(course);
+        trie.Compact();
+        });
+}
+
+void IngestPipeline::AddSink(StaticIndex& index) {
+    AddSink("StaticIndex", [&index](const vector<Course>& records) {
+        index.Build(records);
+        });
+}
+
+// --- Fan-out ---
+vector<IngestPipeline::SinkTiming> IngestPipeline::FanOut(const CourseBatch& batch) const {
+    vector<SinkTiming> timings;
+    timings.reserve(sinks.size());
+    for (const auto& sink : sinks) {
+        auto startTime = chrono::high_resolution_clock::now();
+        sink.second(batch.records);
+        auto endTime = chrono::high_resolution_clock::now();
+        timings.push_back({ sink.first, chrono::duration_cast<chrono::milliseconds>(endTime - startTime).count() });
+    }
+    return timings;
+}
+
+size_t IngestPipeline::SinkCount() const {
+    return sinks.size();
+}
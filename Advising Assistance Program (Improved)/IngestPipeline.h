@@ -0,0 +1,84 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+#include "Course.h"
+#include "HashTable.h"
+#include "RedBlackTree.h"
+#include "FrozenCatalog.h"
+#include "ConcurrentHashTable.h"
+#include "CourseTrie.h"
+#include "StaticIndex.h"
+
+/**
+ * @file IngestPipeline.h
+ * @brief Parse a course file once and fan the records out to several indexes.
+ *
+ * loadCourses() parses the file for every index it fills. When several
+ * indexes (or a benchmark and its key pools) need the same catalog, the file
+ * is parsed once into a CourseBatch instead, and an IngestPipeline hands that
+ * batch to each registered sink in turn. Parse and per-sink insert times are
+ * recorded separately.
+ */
+
+ /**
+  * @brief Every valid record of one file, in file order (duplicates kept;
+  *        sinks resolve them last-wins as loadCourses does).
+  */
+struct CourseBatch {
+    std::string sourceName;
+    std::vector<Course> records;
+    long long parseMs = 0;
+};
+
+class IngestPipeline {
+public:
+    /** Insert phase of one index: receives the whole batch. */
+    using Sink = std::function<void(const std::vector<Course>&)>;
+
+    /** Insert time of one sink during FanOut. */
+    struct SinkTiming {
+        std::string name;
+        long long insertMs = 0;
+    };
+
+    /**
+     * @brief Parse `fileName` into `batch`, replacing its contents.
+     * @return False if the file could not be opened (an error is printed).
+     */
+    static bool Parse(const std::string& fileName, CourseBatch& batch);
+
+    /** @brief Register a custom sink under a display name. */
+    void AddSink(std::string name, Sink sink);
+
+    /** @brief Upsert into a HashTable. */
+    void AddSink(HashTable& table);
+
+    /** @brief Bulk-build an empty RedBlackTree; upsert into a non-empty one. */
+    void AddSink(RedBlackTree& tree);
+
+    /** @brief Rebuild a FrozenCatalog from the batch. */
+    void AddSink(FrozenCatalog& catalog);
+
+    /** @brief Upsert into a ConcurrentHashTable as one published batch. */
+    void AddSink(ConcurrentHashTable& table);
+
+    /** @brief Upsert into a CourseTrie, then compact it. */
+    void AddSink(CourseTrie& trie);
+
+    /** @brief Rebuild a StaticIndex from the batch. */
+    void AddSink(StaticIndex& index);
+
+    /**
+     * @brief Feed the batch to every sink in registration order.
+     * @return Insert time of each sink, in the same order.
+     */
+    std::vector<SinkTiming> FanOut(const CourseBatch& batch) const;
+
+    /** @return Number of registered sinks. */
+    size_t SinkCount() const;
+
+private:
+    std::vector<std::pair<std::string, Sink>> sinks;
+};
@@ -0,0 +1,112 @@
+#include "InternedCatalog.h"
+using namespace std;
+
+InternedCatalog::InternedCatalog() {
+    Clear();
+}
+
+// --- Build ---
+/**
+ * @brief Two passes: intern every number and note the last record for each,
+ *        then copy the surviving records in input order.
+ */
+void InternedCatalog::Build(const vector<Course>& courses) {
+    Clear();
+
+    vector<size_t> lastRecord;
+    for (size_t i = 0; i < courses.size(); ++i) {
+        uint32_t id = numbers.Intern(courses[i].number);
+        if (id >= lastRecord.size()) lastRecord.resize(id + 1);
+        lastRecord[id] = i;
+    }
+
+    for (size_t i = 0; i < courses.size(); ++i) {
+        const Course& course = courses[i];
+        uint32_t id = numbers.Find(course.number);
+        if (lastRecord[id] != i) continue; // replaced by a later record
+
+        numberIds.push_back(id);
+        titleText += course.title;
+        titleOffsets.push_back(static_cast<uint32_t>(titleText.size()));
+        for (const string& prerequisite : course.prerequisites) {
+            prerequisiteIds.push_back(numbers.Intern(prerequisite));
+        }
+        prerequisiteOffsets.push_back(static_cast<uint32_t>(prerequisiteIds.size()));
+    }
+
+    courseOfId.assign(numbers.Size(), NOT_FOUND);
+    for (uint32_t position = 0; position < numberIds.size(); ++position) {
+        courseOfId[numberIds[position]] = position;
+    }
+
+    numberIds.shrink_to_fit();
+    titleText.shrink_to_fit();
+    titleOffsets.shrink_to_fit();
+    prerequisiteOffsets.shrink_to_fit();
+    prerequisiteIds.shrink_to_fit();
+}
+
+// --- Lookups ---
+uint32_t InternedCatalog::Find(string_view courseNumber) const {
+    uint32_t id = numbers.Find(courseNumber);
+    return id == StringInterner::NOT_FOUND ? NOT_FOUND : courseOfId[id];
+}
+
+string_view InternedCatalog::Number(uint32_t position) const {
+    return numbers.Get(numberIds[position]);
+}
+
+string_view InternedCatalog::Title(uint32_t position) const {
+    return string_view(titleText.data() + titleOffsets[position],
+        titleOffsets[position + 1] - titleOffsets[position]);
+}
+
+InternedCatalog::IdSpan InternedCatalog::Prerequisites(uint32_t position) const {
+    const uint32_t* base = prerequisiteIds.data();
+    return IdSpan{ base + prerequisiteOffsets[position], base + prerequisiteOffsets[position + 1] };
+}
+
+string_view InternedCatalog::Name(uint32_t id) const {
+    return numbers.Get(id);
+}
+
+uint32_t InternedCatalog::CourseOf(uint32_t id) const {
+    return id < courseOfId.size() ? courseOfId[id] : NOT_FOUND;
+}
+
+Course InternedCatalog::ToCourse(uint32_t position) const {
+    Course course;
+    course.number.assign(Number(position));
+    course.title.assign(Title(position));
+    for (uint32_t id : Prerequisites(position)) course.prerequisites.emplace_back(Name(id));
+    return course;
+}
+
+// --- Size ---
+size_t InternedCatalog::Size() const {
+    return numberIds.size();
+}
+
+size_t InternedCatalog::MemoryBytes() const {
+    return numbers.MemoryBytes()
+        + numberIds.capacity() * sizeof(uint32_t)
+        + titleText.capacity()
+        + titleOffsets.capacity() * sizeof(uint32_t)
+        + prerequisiteOffsets.capacity() * sizeof(uint32_t)
+        + prerequisiteIds.capacity() * sizeof(uint32_t)
+        + courseOfId.capacity() * sizeof(uint32_t);
+}
+
+const StringInterner& InternedCatalog::Numbers() const {
+    return numbers;
+}
+
+void InternedCatalog::Clear() {
+    numbers.Clear();
+    numberIds.clear();
+    titleText.clear();
+    titleOffsets.assign(1, 0);
+    prerequisiteOffsets.assign(1, 0);
+    prerequisiteIds.clear();
+    courseOfId.clear();
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Course.h"
+#include "StringInterner.h"
+
+/**
+ * @file InternedCatalog.h
+ * @brief Compact catalog in which course numbers are interned IDs and
+ *        prerequisites are ID spans.
+ *
+ * A Course keeps its own std::string for every prerequisite, so "CS101" is
+ * stored again by every course that requires it. Here every course number,
+ * whether it names a course or only appears as a prerequisite, is interned
+ * once in a StringInterner. Each course's prerequisites are then a span of
+ * 4-byte IDs in one contiguous array (CSR layout: prerequisiteOffsets[c]
+ * .. prerequisiteOffsets[c + 1]). Titles live back to back in one arena.
+ *
+ * Courses are addressed by a dense position. A prerequisite ID maps to the
+ * course it names in O(1) (CourseOf), without a string lookup.
+ */
+class InternedCatalog {
+public:
+    /** Returned for a course number or ID that names no course. */
+    static constexpr uint32_t NOT_FOUND = UINT32_MAX;
+
+    /** Contiguous run of interned IDs. */
+    struct IdSpan {
+        const uint32_t* first;
+        const uint32_t* last;
+        const uint32_t* begin() const { return first; }
+        const uint32_t* end() const { return last; }
+        size_t size() const { return static_cast<size_t>(last - first); }
+    };
+
+    InternedCatalog();
+
+    /**
+     * @brief Replace the contents with `courses`. Duplicate numbers
+     *        (case-insensitive) resolve last-wins, as in the other indexes.
+     */
+    void Build(const std::vector<Course>& courses);
+
+    /** @return Position of the course with this number, or NOT_FOUND. */
+    uint32_t Find(std::string_view courseNumber) const;
+
+    /** @return Catalog number of the course at `position`. */
+    std::string_view Number(uint32_t position) const;
+
+    /** @return Title of the course at `position`. */
+    std::string_view Title(uint32_t position) const;
+
+    /** @return Interned IDs of the course's prerequisites, in file order. */
+    IdSpan Prerequisites(uint32_t position) const;
+
+    /** @return Course number for an interned ID. */
+    std::string_view Name(uint32_t id) const;
+
+    /** @return Position of the course an interned ID names, or NOT_FOUND. */
+    uint32_t CourseOf(uint32_t id) const;
+
+    /** @return An owning Course copy of the course at `position`. */
+    Course ToCourse(uint32_t position) const;
+
+    /** @return Number of courses. */
+    size_t Size() const;
+
+    /** @return Bytes held by every array and arena (capacity). */
+    size_t MemoryBytes() const;
+
+    /** @return The course-number interner (courses and prerequisites). */
+    const StringInterner& Numbers() const;
+
+    /** @brief Remove every course and interned string. */
+    void Clear();
+
+private:
+    StringInterner numbers;
+    std::vector<uint32_t> numberIds;           // per course: interned ID of its number
+    std::string titleText;                     // every title, back to back
+    std::vector<uint32_t> titleOffsets;        // per course, plus end
+    std::vector<uint32_t> prerequisiteOffsets; // per course, plus end
+    std::vector<uint32_t> prerequisiteIds;     // all spans, back to back
+    std::vector<uint32_t> courseOfId;          // interned ID -> position, or NOT_FOUND
+};
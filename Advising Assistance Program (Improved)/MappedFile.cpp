@@ -0,0 +1,111 @@
+#include "MappedFile.h"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+#if defined(_WIN32)
+MappedFile::MappedFile()
+    : data(nullptr), size(0), open(false), fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr) {
+}
+#else
+MappedFile::MappedFile() : data(nullptr), size(0), open(false) {}
+#endif
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+bool MappedFile::IsOpen() const {
+    return open;
+}
+
+string_view MappedFile::Text() const {
+    return data ? string_view(data, size) : string_view();
+}
+
+#if defined(_WIN32)
+bool MappedFile::Open(const string& fileName) {
+    Close();
+    HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    open = true;
+    if (fileSize.QuadPart == 0) return true; // empty files cannot be mapped
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (mapping) CloseHandle(mapping);
+        Close();
+        return false;
+    }
+    mappingHandle = mapping;
+    data = static_cast<const char*>(view);
+    size = static_cast<size_t>(fileSize.QuadPart);
+    return true;
+}
+
+void MappedFile::Close() {
+    if (data) UnmapViewOfFile(data);
+    if (mappingHandle) CloseHandle(static_cast<HANDLE>(mappingHandle));
+    if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(static_cast<HANDLE>(fileHandle));
+    data = nullptr;
+    size = 0;
+    open = false;
+    mappingHandle = nullptr;
+    fileHandle = INVALID_HANDLE_VALUE;
+}
+#else
+bool MappedFile::Open(const string& fileName) {
+    Close();
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+    open = true;
+    if (info.st_size == 0) { // empty files cannot be mapped
+        ::close(fd);
+        return true;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // the mapping keeps the file referenced
+    if (view == MAP_FAILED) {
+        open = false;
+        return false;
+    }
+    madvise(view, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+    data = static_cast<const char*>(view);
+    size = static_cast<size_t>(info.st_size);
+    return true;
+}
+
+void MappedFile::Close() {
+    if (data) munmap(const_cast<char*>(data), size);
+    data = nullptr;
+    size = 0;
+    open = false;
+}
+#endif
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/**
+ * @file MappedFile.h
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * The file's bytes are mapped straight into the address space (mmap on
+ * POSIX, a file mapping view on Windows), so a parser can tokenize them in
+ * place as string_views without first copying lines into std::strings. The
+ * mapping lives as long as the object; views into Text() must not outlive it.
+ */
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Map `fileName`, replacing any previous mapping.
+     * @return False if the file could not be opened or mapped.
+     */
+    bool Open(const std::string& fileName);
+
+    /** @brief Unmap the file (no-op if nothing is mapped). */
+    void Close();
+
+    /** @return True if a file is mapped (an empty file counts as mapped). */
+    bool IsOpen() const;
+
+    /** @return The whole file as one view; empty if nothing is mapped. */
+    std::string_view Text() const;
+
+private:
+    const char* data;
+    size_t size;
+    bool open;
+#if defined(_WIN32)
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+};
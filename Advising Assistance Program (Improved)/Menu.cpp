@@ -1,9 +1,14 @@
 #include "Menu.h"
 #include "FileLoader.h"
 #include "Benchmark.h"
+#include <cstdio>
+#include <iomanip>
 #include <iostream>
 #include <limits>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 using namespace std;
 
 namespace {
@@ -65,30 +70,140 @@ namespace {
         cout << "Dataset:          " << r.datasetName << endl;
         cout << "Courses:          " << r.numCourses << endl;
         cout << "Search trials:    " << r.numSearchTrials << endl;
+        cout << "Parse time (ms):  " << r.parseMs << endl;
         cout << "Build time (ms):  " << r.buildMs << endl;
         cout << "Hit search (ms):  " << r.searchHitMs << endl;
         cout << "Miss search (ms): " << r.searchMissMs << endl;
         cout << "Mixed (ms):       " << r.mixedMs << endl;
         cout << "Range (ms):       " << r.rangeMs << endl;
+        cout << "Range matches:    " << r.rangeMatches << endl;
+        cout << "Batch hits (ms):  " << r.batchMs << endl;
+        cout << "Churn (ms):       " << r.churnMs << endl;
+        if (r.structureBytes > 0) {
+            cout << "Structure bytes:  " << r.structureBytes << endl;
+        }
+        if (r.insertBuildMs > 0 || r.bulkBuildMs > 0) {
+            cout << "Insert build (ms):" << r.insertBuildMs << endl;
+            cout << "Bulk build (ms):  " << r.bulkBuildMs << endl;
+        }
         cout << "=========================\n" << endl;
     }
 
     /**
-     * Show a side-by-side summary for HashTable vs. RedBlackTree.
+     * Show a side-by-side summary for several labelled results (e.g., HT, RBT, FZ).
      */
-    void printBenchComparison(const BenchResult& benchHT, const BenchResult& benchRBT) {
+    void printBenchComparison(const vector<pair<string, BenchResult>>& results) {
+        if (results.empty()) return;
+        const BenchResult& first = results.front().second;
+
+        // Print one row: a label followed by "NAME=value" for every structure
+        auto row = [&](const char* label, auto BenchResult::* field) {
+            cout << label;
+            for (size_t i = 0; i < results.size(); ++i) {
+                if (i > 0) cout << "   ";
+                cout << results[i].first << "=" << results[i].second.*field;
+            }
+            cout << "\n";
+        };
+
         cout << "\n=== Side-by-Side ===\n";
-        cout << "Dataset: " << benchHT.datasetName
-            << " (Courses: " << benchHT.numCourses
-            << ", Trials: " << benchHT.numSearchTrials << ")\n";
-        cout << "Build (ms):       HT=" << benchHT.buildMs << "   RBT=" << benchRBT.buildMs << "\n";
-        cout << "Hit search (ms):  HT=" << benchHT.searchHitMs << "   RBT=" << benchRBT.searchHitMs << "\n";
-        cout << "Miss search (ms): HT=" << benchHT.searchMissMs << "   RBT=" << benchRBT.searchMissMs << "\n";
-        cout << "Mixed (ms):       HT=" << benchHT.mixedMs << "   RBT=" << benchRBT.mixedMs << "\n";
-        cout << "Range (ms):       HT=" << benchHT.rangeMs << "   RBT=" << benchRBT.rangeMs << "\n";
+        cout << "Dataset: " << first.datasetName
+            << " (Courses: " << first.numCourses
+            << ", Trials: " << first.numSearchTrials
+            << ", parsed once in " << first.parseMs << " ms)\n";
+        row("Build (ms):       ", &BenchResult::buildMs);
+        row("Hit search (ms):  ", &BenchResult::searchHitMs);
+        row("Miss search (ms): ", &BenchResult::searchMissMs);
+        row("Mixed (ms):       ", &BenchResult::mixedMs);
+        row("Range (ms):       ", &BenchResult::rangeMs);
+        row("Range matches:    ", &BenchResult::rangeMatches);
+        row("Batch hits (ms):  ", &BenchResult::batchMs);
+        row("Churn (ms):       ", &BenchResult::churnMs);
+        for (const auto& labelled : results) {
+            const BenchResult& r = labelled.second;
+            if (r.insertBuildMs == 0 && r.bulkBuildMs == 0) continue;
+            cout << labelled.first << " insert vs bulk build (ms): "
+                << r.insertBuildMs << " vs " << r.bulkBuildMs << "\n";
+        }
+        for (const auto& labelled : results) {
+            if (labelled.second.structureBytes == 0) continue;
+            cout << labelled.first << " structure bytes: " << labelled.second.structureBytes << "\n";
+        }
         cout << "====================\n" << endl;
     }
 
+    /**
+     * Print bytes per course for Course records and the interned catalog.
+     */
+    void printMemoryFootprint(const MemoryFootprintResult& r) {
+        cout << "\n=== Memory per Course ===" << endl;
+        cout << "Dataset: " << r.datasetName << " (" << r.courses << " courses, "
+            << r.prerequisiteRefs << " prerequisite references, "
+            << r.internedStrings << " distinct course numbers)" << endl;
+        cout << fixed << setprecision(1);
+        cout << "Course records:   " << r.courseBytes << " bytes   "
+            << r.courseBytesPerCourse << " bytes/course" << endl;
+        cout << "Catalog store:    " << r.storeBytes << " bytes   "
+            << r.storeBytesPerCourse << " bytes/course" << endl;
+        cout << "HashTable:        " << r.hashTableBytes << " bytes   "
+            << r.hashTableBytesPerCourse << " bytes/course" << endl;
+        cout << "RedBlackTree:     " << r.treeBytes << " bytes   "
+            << r.treeBytesPerCourse << " bytes/course" << endl;
+        cout << "Interned catalog: " << r.internedBytes << " bytes   "
+            << r.internedBytesPerCourse << " bytes/course" << endl;
+        cout << defaultfloat;
+        cout << "=========================\n" << endl;
+    }
+
+    /**
+     * Print parse time and MB/s for each loader variant.
+     */
+    void printLoaderThroughput(const LoaderThroughputResult& r) {
+        cout << "\n=== Loader Throughput ===" << endl;
+        cout << "Dataset: " << r.datasetName << " (" << r.bytes << " bytes, "
+            << r.records << " records)" << endl;
+        cout << fixed << setprecision(1);
+        cout << "getline + istringstream: " << r.baselineMs << " ms   " << r.baselineMBps << " MB/s" << endl;
+        cout << "mmap + string_view:      " << r.mappedMs << " ms   " << r.mappedMBps << " MB/s" << endl;
+        cout << "mmap, " << setw(2) << r.parserThreads << " parse threads:  " << r.parallelMs << " ms   "
+            << r.parallelMBps << " MB/s" << endl;
+        cout << "open binary snapshot:    " << r.snapshotOpenMs << " ms" << endl;
+        cout << defaultfloat;
+        cout << "=========================\n" << endl;
+    }
+
+    /**
+     * Print department and level-band query times for each approach.
+     */
+    void printDepartmentRanges(const DepartmentRangeResult& r) {
+        cout << "\n=== Department / Level Ranges ===" << endl;
+        cout << "Dataset: " << r.datasetName << endl;
+        cout << "DepartmentIndex build: " << r.indexBuildMs << " ms" << endl;
+        cout << "Queries: " << r.department << " (all levels), " << r.department
+            << " " << r.level << "-level" << endl;
+        cout << "Full walk (HT):       " << r.walkDepartmentMs << " ms (" << r.walkDepartmentMatches << ")   "
+            << r.walkLevelMs << " ms (" << r.walkLevelMatches << ")" << endl;
+        cout << "Prefix seek (RBT):    " << r.seekDepartmentMs << " ms (" << r.seekDepartmentMatches << ")   "
+            << r.seekLevelMs << " ms (" << r.seekLevelMatches << ")" << endl;
+        cout << "DepartmentIndex:      " << r.indexDepartmentMs << " ms (" << r.indexDepartmentMatches << ")   "
+            << r.indexLevelMs << " ms (" << r.indexLevelMatches << ")" << endl;
+        cout << "=================================\n" << endl;
+    }
+
+    void printThreadScaling(const string& title, const string& datasetName, const vector<ThreadScalingResult>& results) {
+        cout << "\n=== " << title << " ===" << endl;
+        cout << "Dataset: " << datasetName << endl;
+        for (const auto& r : results) {
+            cout << "Threads: " << setw(3) << r.threads
+                << "   Lookups: " << r.lookups
+                << "   Time (ms): " << r.elapsedMs
+                << "   Lookups/sec: " << fixed << setprecision(0) << r.lookupsPerSec;
+            if (r.writerUpdates > 0) cout << "   Writer upserts: " << r.writerUpdates;
+            cout << defaultfloat << endl;
+        }
+        cout << "====================================\n" << endl;
+    }
+
 } // namespace
 
 /**
@@ -96,6 +211,7 @@ namespace {
  * Operations act on the provided Red-Black Tree instance.
  */
 void displayMenu(RedBlackTree& courseTree) {
+    DepartmentIndex departments; // rebuilt from courseTree after every load
     int choice = 0;
 
     while (choice != 9) {
@@ -103,7 +219,10 @@ void displayMenu(RedBlackTree& courseTree) {
             << "1. Load courses from file\n"
             << "2. Print all courses\n"
             << "3. Print course information\n"
-            << "4. Run benchmarks (HT / RBT / Both)\n"
+            << "4. Run benchmarks (HT / RBT / Frozen / Static / Trie / All / Concurrent)\n"
+            << "5. Print a page of courses\n"
+            << "6. Find a course's position in the catalog\n"
+            << "7. List courses by department and level\n"
             << "9. Exit\n"
             << "Enter your choice: ";
 
@@ -112,11 +231,11 @@ void displayMenu(RedBlackTree& courseTree) {
         switch (choice) {
         case 1: {
             string fileName;
-            cout << "Enter the filename: ";
+            cout << "Enter the filename (CSV or .snap): ";
             getline(cin >> ws, fileName);
 
-            courseTree.Clear();
-            loadCourses(courseTree, fileName);  // RBT overload
+            loadCatalog(courseTree, fileName);  // snapshot-aware RBT load
+            departments.Build(courseTree);
             break;
         }
         case 2: {
@@ -132,8 +251,8 @@ void displayMenu(RedBlackTree& courseTree) {
             cout << endl;
 
             // Search is case-insensitive internally
-            Course course = courseTree.Search(courseNumber);
-            if (!course.number.empty()) {
+            CourseView course = courseTree.Find(courseNumber);
+            if (course) {
                 cout << "Course: " << course.number
                     << ", " << course.title << endl;
                 cout << "Prerequisites: ";
@@ -158,10 +277,70 @@ void displayMenu(RedBlackTree& courseTree) {
             cout << "Enter dataset filename for benchmark: ";
             getline(cin >> ws, fileName);
 
-            cout << "Select data structure: 1) HashTable  2) RedBlackTree  3) Both  [3]: ";
+            cout << "Select data structure: 1) HashTable  2) RedBlackTree  3) FrozenCatalog  4) All"
+                << "  5) Concurrent HashTable thread scaling  6) StaticIndex"
+                << "  7) Persistent RBT snapshot readers  8) CourseTrie  9) Loader throughput"
+                << "  10) Memory per course  11) Department/level ranges  [4]: ";
             string dsChoiceLine;
             getline(cin, dsChoiceLine);
-            int dsChoice = dsChoiceLine.empty() ? 3 : stoi(dsChoiceLine);
+            int dsChoice = dsChoiceLine.empty() ? 4 : stoi(dsChoiceLine);
+
+            if (dsChoice == 9) {
+                printLoaderThroughput(RunLoaderThroughputBenchmark(fileName));
+                size_t rows = getValidatedSizeT("Rows for a generated catalog (0 to skip)", 0);
+                if (rows > 0) {
+                    // Scratch input: deleted, with the snapshot compiled from it, once measured
+                    string generated = "generated_catalog_" + to_string(rows) + ".csv";
+                    if (GenerateCatalogFile(generated, rows)) {
+                        printLoaderThroughput(RunLoaderThroughputBenchmark(generated));
+                    }
+                    remove(generated.c_str());
+                    remove((generated + CatalogSnapshot::EXTENSION).c_str());
+                }
+                break;
+            }
+
+            if (dsChoice == 10) {
+                CourseBatch batch;
+                if (IngestPipeline::Parse(fileName, batch)) {
+                    printMemoryFootprint(RunMemoryFootprintBenchmark(batch));
+                }
+                break;
+            }
+
+            if (dsChoice == 11) {
+                string department = "CS";
+                cout << "Department to query [CS]: ";
+                {
+                    string line; getline(cin, line);
+                    if (!line.empty()) department = line;
+                }
+                size_t level = getValidatedSizeT("Level to query (e.g., 300)", 300);
+                CourseBatch batch;
+                if (IngestPipeline::Parse(fileName, batch)) {
+                    printDepartmentRanges(RunDepartmentRangeBenchmark(batch, department,
+                        static_cast<uint32_t>(level)));
+                }
+                break;
+            }
+
+            if (dsChoice == 5 || dsChoice == 7) {
+                size_t hardwareThreads = thread::hardware_concurrency();
+                size_t maxThreads = getValidatedSizeT("Maximum reader threads",
+                    hardwareThreads > 0 ? hardwareThreads : 4);
+                size_t lookups = getValidatedSizeT("Lookups per thread", 200000);
+                size_t writer = getValidatedSizeT("Run a concurrent writer (0/1)", 0);
+
+                if (dsChoice == 5) {
+                    printThreadScaling("Concurrent HashTable Scaling", fileName,
+                        RunConcurrentLookupBenchmark(fileName, maxThreads, lookups, writer != 0));
+                }
+                else {
+                    printThreadScaling("Persistent RBT Snapshot Readers", fileName,
+                        RunSnapshotLookupBenchmark(fileName, maxThreads, lookups, writer != 0));
+                }
+                break;
+            }
 
             size_t trials = getValidatedSizeT("Number of search trials (per phase)", 5000);
             double hitRatio = getValidatedDouble("Mixed workload hit ratio (0..1)", 0.5);
@@ -175,21 +354,114 @@ void displayMenu(RedBlackTree& courseTree) {
                 if (!line.empty()) prefix = line;
             }
 
+            // Parse once; every structure below builds from the same batch
+            CourseBatch batch;
+            if (!IngestPipeline::Parse(fileName, batch)) break;
+
             if (dsChoice == 1) {
-                BenchResult a = RunHashTableBenchmark(fileName, trials, hitRatio, prefix);
+                BenchResult a = RunHashTableBenchmark(batch, trials, hitRatio, prefix);
                 printBench(a);
             }
             else if (dsChoice == 2) {
-                BenchResult b = RunRBTBenchmark(fileName, trials, hitRatio, prefix);
+                BenchResult b = RunRBTBenchmark(batch, trials, hitRatio, prefix);
                 printBench(b);
             }
+            else if (dsChoice == 3) {
+                BenchResult c = RunFrozenCatalogBenchmark(batch, trials, hitRatio, prefix);
+                printBench(c);
+            }
+            else if (dsChoice == 6) {
+                BenchResult d = RunStaticIndexBenchmark(batch, trials, hitRatio, prefix);
+                printBench(d);
+            }
+            else if (dsChoice == 8) {
+                BenchResult e = RunTrieBenchmark(batch, trials, hitRatio, prefix);
+                printBench(e);
+            }
             else {
-                BenchResult a = RunHashTableBenchmark(fileName, trials, hitRatio, prefix);
-                BenchResult b = RunRBTBenchmark(fileName, trials, hitRatio, prefix);
-                printBenchComparison(a, b);
+                BenchResult a = RunHashTableBenchmark(batch, trials, hitRatio, prefix);
+                BenchResult b = RunRBTBenchmark(batch, trials, hitRatio, prefix);
+                BenchResult c = RunFrozenCatalogBenchmark(batch, trials, hitRatio, prefix);
+                BenchResult d = RunStaticIndexBenchmark(batch, trials, hitRatio, prefix);
+                BenchResult e = RunTrieBenchmark(batch, trials, hitRatio, prefix);
+                printBenchComparison({ { "HT", a }, { "RBT", b }, { "FZ", c }, { "SI", d }, { "TR", e } });
             }
             break;
         }
+        case 5: {
+            if (courseTree.Size() == 0) {
+                cout << "No courses loaded.\n" << endl;
+                break;
+            }
+            size_t first = getValidatedSizeT("First course position (1-based)", 1);
+            size_t pageSize = getValidatedSizeT("Courses per page", 50);
+            if (first == 0) first = 1;
+            cout << endl;
+
+            size_t printed = courseTree.PrintPage(first - 1, pageSize);
+            if (printed == 0) {
+                cout << "Position is past the end of the catalog." << endl;
+            }
+            else {
+                cout << "\nShowing courses " << first << "-" << (first + printed - 1)
+                    << " of " << courseTree.Size() << "." << endl;
+            }
+            cout << endl;
+            break;
+        }
+        case 6: {
+            string courseNumber;
+            cout << "Enter a course number: ";
+            getline(cin >> ws, courseNumber);
+
+            // Rank counts courses sorting before the key, stored or not
+            size_t before = courseTree.Rank(courseNumber);
+            cout << "\n" << before << " of " << courseTree.Size()
+                << " courses sort before " << courseNumber << "." << endl;
+            if (courseTree.Find(courseNumber)) {
+                cout << "It is course " << (before + 1) << " in catalog order." << endl;
+            }
+            cout << endl;
+            break;
+        }
+        case 7: {
+            string department;
+            cout << "Enter a department (e.g., CS): ";
+            getline(cin >> ws, department);
+            cout << "Level (e.g., 300, blank for all levels): ";
+            string levelLine;
+            getline(cin, levelLine);
+            cout << endl;
+
+            // A level is 0-999 ("3" is accepted for 300); anything else is rejected
+            bool validLevel = levelLine.size() <= 3
+                && levelLine.find_first_not_of("0123456789") == string::npos;
+            if (!validLevel) {
+                cout << "Invalid level. Enter a number from 0 to 999, or leave it blank.\n" << endl;
+                break;
+            }
+
+            auto print = [](const CourseView& course) {
+                cout << course.number << ", " << course.title << endl;
+            };
+            size_t shown = 0;
+            if (levelLine.empty()) {
+                shown = departments.Department(department, print);
+            }
+            else {
+                uint32_t level = static_cast<uint32_t>(stoul(levelLine));
+                if (level < DepartmentIndex::LEVELS) level *= 100;
+                shown = departments.LevelBand(department, level, level, print);
+            }
+            if (shown == 0) {
+                cout << "No matching courses." << endl;
+            }
+            else {
+                cout << "\n" << shown << " course(s)." << endl;
+            }
+            cout << endl;
+            break;
+        }
         case 9:
             cout << "Thank you for using the course planner!" << endl;
             break;
@@ -0,0 +1,217 @@
+#include "PersistentRedBlackTree.h"
+using namespace std;
+
+PersistentRedBlackTree::Entry::Entry(const Course& c) : data(c), key(c.number) {
+    for (char& ch : key) ch = FoldKeyChar(ch);
+}
+
+// --- Lifecycle ---
+PersistentRedBlackTree::PersistentRedBlackTree() : published(make_shared<Version>()) {
+    current.store(published.get());
+}
+
+PersistentRedBlackTree::~PersistentRedBlackTree() {
+    current.store(nullptr);
+}
+
+// --- Path copying ---
+PersistentRedBlackTree::NodePtr PersistentRedBlackTree::MakeNode(Color color, NodePtr left,
+    const Node& payload, NodePtr right) {
+    return make_shared<const Node>(Node{ payload.keyHead, color, payload.entry, std::move(left), std::move(right) });
+}
+
+/**
+ * @brief Okasaki's balance: a black node with a red child that has a red
+ *        child becomes a red node over two black ones. The four cases differ
+ *        only in which three payloads and four subtrees are picked.
+ */
+PersistentRedBlackTree::NodePtr PersistentRedBlackTree::Balance(Color color, NodePtr left,
+    const Node& payload, NodePtr right) {
+    auto isRed = [](const NodePtr& n) { return n && n->color == RED; };
+
+    if (color == BLACK) {
+        if (isRed(left) && isRed(left->left)) {
+            const NodePtr& ll = left->left;
+            return MakeNode(RED, MakeNode(BLACK, ll->left, *ll, ll->right), *left,
+                MakeNode(BLACK, left->right, payload, std::move(right)));
+        }
+        if (isRed(left) && isRed(left->right)) {
+            const NodePtr& lr = left->right;
+            return MakeNode(RED, MakeNode(BLACK, left->left, *left, lr->left), *lr,
+                MakeNode(BLACK, lr->right, payload, std::move(right)));
+        }
+        if (isRed(right) && isRed(right->left)) {
+            const NodePtr& rl = right->left;
+            return MakeNode(RED, MakeNode(BLACK, std::move(left), payload, rl->left), *rl,
+                MakeNode(BLACK, rl->right, *right, right->right));
+        }
+        if (isRed(right) && isRed(right->right)) {
+            const NodePtr& rr = right->right;
+            return MakeNode(RED, MakeNode(BLACK, std::move(left), payload, right->left), *right,
+                MakeNode(BLACK, rr->left, *rr, rr->right));
+        }
+    }
+    return MakeNode(color, std::move(left), payload, std::move(right));
+}
+
+/**
+ * @brief Copy the search path down to the key, rebalancing on the way back
+ *        up. Subtrees off the path are shared with the previous version.
+ */
+PersistentRedBlackTree::NodePtr PersistentRedBlackTree::InsertPath(const NodePtr& node,
+    const shared_ptr<const Entry>& entry, uint64_t keyHead, bool& added) {
+    if (!node) {
+        added = true;
+        return make_shared<const Node>(Node{ keyHead, RED, entry, nullptr, nullptr });
+    }
+
+    int cmp = keyHead != node->keyHead ? (keyHead < node->keyHead ? -1 : 1)
+        : CompareCourseKeys(entry->key, node->entry->key);
+    if (cmp < 0) {
+        return Balance(node->color, InsertPath(node->left, entry, keyHead, added), *node, node->right);
+    }
+    if (cmp > 0) {
+        return Balance(node->color, node->left, *node, InsertPath(node->right, entry, keyHead, added));
+    }
+
+    // Same key: new payload, same shape
+    return MakeNode(node->color, node->left, Node{ keyHead, node->color, entry, nullptr, nullptr }, node->right);
+}
+
+// --- Writers ---
+/**
+ * @brief Swap the writer's reference, make the new version visible, then
+ *        wait out lock-free readers before the old reference is dropped.
+ *        Pinned snapshots keep their version alive on their own.
+ */
+void PersistentRedBlackTree::Publish(shared_ptr<Version> next) {
+    next->number = published->number + 1;
+    shared_ptr<const Version> previous = std::move(published);
+    published = std::move(next);
+    current.store(published.get(), memory_order_release);
+    readers.WaitForReaders();
+}
+
+void PersistentRedBlackTree::Insert(const Course& course) {
+    InsertBatch(vector<Course>{ course });
+}
+
+void PersistentRedBlackTree::InsertBatch(const vector<Course>& courses) {
+    lock_guard<mutex> guard(writeLock);
+    auto next = make_shared<Version>();
+    next->root = published->root;
+    next->size = published->size;
+
+    // Intermediate roots are private to this call; only the last is published
+    for (const Course& course : courses) {
+        auto entry = make_shared<const Entry>(course);
+        bool added = false;
+        NodePtr root = InsertPath(next->root, entry, PackCourseKeyHead(entry->key), added);
+        if (root->color == RED) root = MakeNode(BLACK, root->left, *root, root->right);
+        next->root = std::move(root);
+        if (added) ++next->size;
+    }
+    Publish(std::move(next));
+}
+
+/**
+ * @brief Build a balanced version directly from the tree's sorted contents
+ *        (middle splits, deepest level red), without any path copying.
+ */
+void PersistentRedBlackTree::Assign(const RedBlackTree& tree) {
+    vector<shared_ptr<const Entry>> entries;
+    entries.reserve(tree.Size());
+    for (CourseView course : tree) entries.push_back(make_shared<const Entry>(course.ToCourse()));
+
+    size_t redDepth = 0;
+    while ((size_t(2) << redDepth) <= entries.size()) ++redDepth;
+
+    function<NodePtr(size_t, size_t, size_t)> build = [&](size_t lo, size_t hi, size_t depth) -> NodePtr {
+        if (lo >= hi) return nullptr;
+        size_t mid = lo + (hi - lo) / 2;
+        const auto& entry = entries[mid];
+        Color color = (depth == redDepth && depth > 0) ? RED : BLACK;
+        return make_shared<const Node>(Node{ PackCourseKeyHead(entry->key), color, entry,
+            build(lo, mid, depth + 1), build(mid + 1, hi, depth + 1) });
+        };
+
+    lock_guard<mutex> guard(writeLock);
+    auto next = make_shared<Version>();
+    next->root = build(0, entries.size(), 0);
+    next->size = entries.size();
+    Publish(std::move(next));
+}
+
+// --- Readers ---
+const PersistentRedBlackTree::Node* PersistentRedBlackTree::FindNode(const Version* version,
+    string_view courseNumber) {
+    uint64_t keyHead = PackCourseKeyHead(courseNumber);
+    const Node* node = version->root.get();
+    while (node) {
+        int cmp = keyHead != node->keyHead ? (keyHead < node->keyHead ? -1 : 1)
+            : CompareCourseKeys(courseNumber, node->entry->key);
+        if (cmp == 0) return node;
+        node = cmp < 0 ? node->left.get() : node->right.get();
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Taking a reference inside the read-side section is safe: the writer
+ *        keeps its own reference to any version a reader could have loaded
+ *        until the grace period ends.
+ */
+PersistentRedBlackTree::Snapshot PersistentRedBlackTree::Pin() const {
+    ReaderEpoch::ReadGuard guard(readers);
+    return Snapshot(current.load(memory_order_acquire)->shared_from_this());
+}
+
+Course PersistentRedBlackTree::Search(string courseNumber) const {
+    ReaderEpoch::ReadGuard guard(readers);
+    const Node* node = FindNode(current.load(memory_order_acquire), courseNumber);
+    return node ? node->entry->data : Course();
+}
+
+bool PersistentRedBlackTree::Contains(string_view courseNumber) const {
+    ReaderEpoch::ReadGuard guard(readers);
+    return FindNode(current.load(memory_order_acquire), courseNumber) != nullptr;
+}
+
+size_t PersistentRedBlackTree::Size() const {
+    ReaderEpoch::ReadGuard guard(readers);
+    return current.load(memory_order_acquire)->size;
+}
+
+// --- Snapshot ---
+const Course* PersistentRedBlackTree::Snapshot::Find(string_view courseNumber) const {
+    if (!version) return nullptr;
+    const Node* node = FindNode(version.get(), courseNumber);
+    return node ? &node->entry->data : nullptr;
+}
+
+/**
+ * @brief In-order walk with an explicit stack; nodes have no parent links.
+ */
+void PersistentRedBlackTree::Snapshot::ForEach(const function<void(const Course&)>& fn) const {
+    if (!version) return;
+    vector<const Node*> stack;
+    const Node* node = version->root.get();
+    while (node || !stack.empty()) {
+        while (node) {
+            stack.push_back(node);
+            node = node->left.get();
+        }
+        node = stack.back();
+        stack.pop_back();
+        fn(node->entry->data);
+        node = node->right.get();
+    }
+}
+
+size_t PersistentRedBlackTree::Snapshot::Size() const {
+    return version ? version->size : 0;
+}
+
+uint64_t PersistentRedBlackTree::Snapshot::VersionNumber() const {
+    return version ? version->number : 0;
+}
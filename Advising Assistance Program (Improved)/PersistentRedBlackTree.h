@@ -0,0 +1,150 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Course.h"
+#include "RedBlackTree.h"
+#include "ReaderEpoch.h"
+
+/**
+ * @file PersistentRedBlackTree.h
+ * @brief Copy-on-write red-black tree whose versions can be read while a
+ *        writer applies updates.
+ *
+ * This is the persistent counterpart of RedBlackTree, for the registration
+ * rush: Insert never mutates a published node. It copies the nodes on the
+ * path from the root to the change (rebalancing on the way back up, as in
+ * Okasaki's functional red-black tree) and publishes the new root as a new
+ * version with one atomic store. Untouched subtrees are shared between
+ * versions.
+ *
+ * Readers either
+ *  - call Search/Contains, which run lock-free inside a ReaderEpoch section
+ *    against whatever version is current, or
+ *  - Pin() a Snapshot: a reference-counted handle to one version that stays
+ *    valid and unchanged for as long as the handle lives.
+ *
+ * Reclamation is reference counted: nodes and versions are held by
+ * shared_ptr, so a node is freed when the last version sharing it goes away.
+ * The writer drops its reference to a replaced version only after a
+ * ReaderEpoch grace period, so lock-free readers that loaded the old version
+ * pointer (and readers that are just pinning it) are never left dangling.
+ */
+class PersistentRedBlackTree {
+private:
+    struct Entry;
+    struct Node;
+    struct Version;
+
+public:
+    /**
+     * @brief Pinned, immutable view of one version of the catalog.
+     *        Cheap to copy; the version is freed when the last copy goes away.
+     */
+    class Snapshot {
+    public:
+        Snapshot() = default;
+
+        /**
+         * @brief Zero-copy lookup by catalog number (case-insensitive).
+         * @return Pointer valid while this snapshot lives, or nullptr.
+         */
+        const Course* Find(std::string_view courseNumber) const;
+
+        /** @brief Apply a function to each course in ascending order. */
+        void ForEach(const std::function<void(const Course&)>& fn) const;
+
+        /** @return Number of courses in this version. */
+        size_t Size() const;
+
+        /** @return Version number; each publish increments it. */
+        uint64_t VersionNumber() const;
+
+    private:
+        friend class PersistentRedBlackTree;
+        explicit Snapshot(std::shared_ptr<const Version> v) : version(std::move(v)) {}
+        std::shared_ptr<const Version> version;
+    };
+
+    PersistentRedBlackTree();
+    ~PersistentRedBlackTree();
+
+    PersistentRedBlackTree(const PersistentRedBlackTree&) = delete;
+    PersistentRedBlackTree& operator=(const PersistentRedBlackTree&) = delete;
+
+    /**
+     * @brief Upsert one course and publish the result as a new version.
+     *        Writers are serialized; readers are never blocked.
+     */
+    void Insert(const Course& course);
+
+    /**
+     * @brief Upsert many courses and publish them as a single version, so
+     *        readers see either none or all of the batch.
+     */
+    void InsertBatch(const std::vector<Course>& courses);
+
+    /** @brief Publish a version holding a copy of every course in `tree`. */
+    void Assign(const RedBlackTree& tree);
+
+    /** @return Snapshot of the current version. Lock-free. */
+    Snapshot Pin() const;
+
+    /**
+     * @brief Lookup in the current version (case-insensitive). Lock-free.
+     * @return Copy of the matching Course, or a default Course if not found.
+     */
+    Course Search(std::string courseNumber) const;
+
+    /** @return True if the current version holds the course. Lock-free. */
+    bool Contains(std::string_view courseNumber) const;
+
+    /** @return Number of courses in the current version. */
+    size_t Size() const;
+
+private:
+    using NodePtr = std::shared_ptr<const Node>;
+
+    /** Shared course record; a node copy on a path keeps pointing at it. */
+    struct Entry {
+        Course data;
+        std::string key; // Canonical (uppercased) data.number.
+        explicit Entry(const Course& c);
+    };
+
+    /** Immutable tree node; published nodes are never modified. */
+    struct Node {
+        uint64_t keyHead; // First 8 bytes of key, see PackCourseKeyHead.
+        Color color;
+        std::shared_ptr<const Entry> entry;
+        NodePtr left;
+        NodePtr right;
+    };
+
+    /** One published tree. */
+    struct Version : std::enable_shared_from_this<Version> {
+        NodePtr root;
+        size_t size = 0;
+        uint64_t number = 0;
+    };
+
+    std::shared_ptr<const Version> published; // writer's reference to the current version
+    std::atomic<const Version*> current;      // what readers load
+    mutable ReaderEpoch readers;
+    std::mutex writeLock;                     // serializes writers
+
+    static NodePtr MakeNode(Color color, NodePtr left, const Node& payload, NodePtr right);
+    static NodePtr Balance(Color color, NodePtr left, const Node& payload, NodePtr right);
+    static NodePtr InsertPath(const NodePtr& node, const std::shared_ptr<const Entry>& entry,
+        uint64_t keyHead, bool& added);
+    static const Node* FindNode(const Version* version, std::string_view courseNumber);
+
+    /** Publish `next`, wait out readers of the old version, then drop it. */
+    void Publish(std::shared_ptr<Version> next);
+};
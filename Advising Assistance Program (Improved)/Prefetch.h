@@ -0,0 +1,25 @@
+#pragma once
+
+/**
+ * @file Prefetch.h
+ * @brief Portable software prefetch hint used by the batched lookup paths.
+ *
+ * Issuing the hint for a bucket or node that will be examined a few steps
+ * later lets its cache miss overlap with work on other keys. On compilers
+ * without a prefetch intrinsic the hint compiles to nothing.
+ */
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+/** Hint that the cache line containing `address` will be read soon. */
+inline void PrefetchRead(const void* address) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address, 0, 3);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+    (void)address;
+#endif
+}
@@ -0,0 +1,60 @@
+#include "ReaderEpoch.h"
+#include <thread>
+using namespace std;
+
+namespace {
+    /** Stripe assigned to the calling thread (round-robin on first use). */
+    size_t ThreadStripe() {
+        static atomic<size_t> nextStripe(0);
+        thread_local size_t stripe = nextStripe.fetch_add(1, memory_order_relaxed);
+        return stripe;
+    }
+}
+
+ReaderEpoch::ReaderEpoch() : epoch(0) {
+    for (ReaderStripe& stripe : stripes) {
+        stripe.active[0].store(0);
+        stripe.active[1].store(0);
+    }
+}
+
+// --- Read-side section ---
+/**
+ * @brief Count this reader under the current epoch parity. If a writer flipped
+ *        the epoch in between, withdraw and retry under the new parity, so a
+ *        writer waiting on the old parity can never miss this reader.
+ */
+atomic<long>& ReaderEpoch::ReadGuard::Enter(const ReaderEpoch& owner) {
+    ReaderStripe& stripe = owner.stripes[ThreadStripe() % READER_STRIPES];
+    while (true) {
+        unsigned int e = owner.epoch.load();
+        atomic<long>& counter = stripe.active[e & 1];
+        counter.fetch_add(1);
+        if (owner.epoch.load() == e) return counter;
+        counter.fetch_sub(1);
+    }
+}
+
+ReaderEpoch::ReadGuard::ReadGuard(const ReaderEpoch& owner)
+    : counter(Enter(owner)) {
+}
+
+ReaderEpoch::ReadGuard::~ReadGuard() {
+    counter.fetch_sub(1, memory_order_release);
+}
+
+// --- Grace period ---
+/**
+ * @brief After the flip, new readers count under the other parity, so once
+ *        the old parity drains no reader can still hold memory that was
+ *        unpublished before the flip.
+ */
+void ReaderEpoch::WaitForReaders() {
+    lock_guard<mutex> guard(graceLock);
+    unsigned int previous = epoch.fetch_add(1);
+    for (ReaderStripe& stripe : stripes) {
+        while (stripe.active[previous & 1].load() != 0) {
+            this_thread::yield();
+        }
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <mutex>
+
+/**
+ * @file ReaderEpoch.h
+ * @brief Epoch-based grace periods for structures with lock-free readers.
+ *
+ * Readers enter a read-side section by counting themselves in a per-thread
+ * stripe under the current epoch parity; they never wait. A writer that has
+ * unpublished some memory calls WaitForReaders(): it flips the epoch and waits
+ * until every reader that entered under the previous parity has left. After
+ * that no reader can still hold a pointer loaded before the unpublish, and
+ * the memory can be freed (RCU style).
+ */
+class ReaderEpoch {
+public:
+    /** Number of reader counter stripes; threads are spread across them. */
+    static constexpr size_t READER_STRIPES = 64;
+
+    ReaderEpoch();
+
+    ReaderEpoch(const ReaderEpoch&) = delete;
+    ReaderEpoch& operator=(const ReaderEpoch&) = delete;
+
+    /** RAII read-side section: announce on entry, withdraw on exit. */
+    class ReadGuard {
+    public:
+        explicit ReadGuard(const ReaderEpoch& epoch);
+        ~ReadGuard();
+
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+    private:
+        std::atomic<long>& counter;
+        static std::atomic<long>& Enter(const ReaderEpoch& epoch);
+    };
+
+    /** Flip the epoch and wait until readers of the previous one have left. */
+    void WaitForReaders();
+
+private:
+    /** Reader counts for the two epoch parities, one cache line per stripe. */
+    struct alignas(64) ReaderStripe {
+        std::atomic<long> active[2];
+    };
+
+    mutable std::array<ReaderStripe, READER_STRIPES> stripes;
+    std::atomic<unsigned int> epoch;
+    std::mutex graceLock; // serializes epoch flips
+};
@@ -1,49 +1,52 @@
 #include "RedBlackTree.h"
+#include "CatalogSnapshot.h"
+#include "Prefetch.h"
 #include <algorithm>
-#include <cctype>
 #include <iostream>
 using namespace std;
 
-// --- Helpers ---
-/**
- * @brief Return an uppercase copy of the input string.
- */
-static string ToUpperCopy(string s) {
-    transform(s.begin(), s.end(), s.begin(), ::toupper);
-    return s;
+RBTNode::RBTNode(uint32_t record, const CourseKey& key)
+    : record(record), color(RED), key(key), parent(nullptr), left(nullptr), right(nullptr), size(1) {}
+
+RedBlackTree::SearchKey RedBlackTree::MakeSearchKey(string_view key) {
+    return SearchKey{ CourseKey(key), key };
 }
 
 /**
- * @brief Compare two string keys case-insensitively.
- * @return -1 if a < b, 1 if a > b, 0 if equal.
+ * @brief Compare a search key with a node key case-insensitively.
+ *        The packed words decide unless both keys are oversized and share
+ *        their inline prefix; only then is the stored number read.
+ * @return -1 if key < node, 1 if key > node, 0 if equal.
  */
-int RedBlackTree::CompareKeys(const string& a, const string& b) {
-    string A = ToUpperCopy(a);
-    string B = ToUpperCopy(b);
-    if (A < B) return -1;
-    if (A > B) return 1;
-    return 0;
+int RedBlackTree::CompareKeys(const SearchKey& key, const RBTNode* node) const {
+    int cmp = key.packed.Compare(node->key);
+    if (cmp != 0 || key.packed.IsInline()) return cmp;
+    return CourseKey::CompareTails(key.text, store.Number(node->record));
 }
 
 // --- Lifecycle ---
-RedBlackTree::RedBlackTree() : root(nullptr) {}
+RedBlackTree::RedBlackTree() : root(nullptr), nodeCount(0) {}
 
 RedBlackTree::~RedBlackTree() {
-    Destroy(root);
+    root = nullptr; // nodePool destroys the nodes
+}
+
+void RedBlackTree::Clear() {
+    // Bulk release: one sweep over the pool's slabs, no tree walk
+    nodePool.ReleaseAll();
+    store.Clear();
     root = nullptr;
+    nodeCount = 0;
 }
 
-void RedBlackTree::Destroy(RBTNode* node) {
-    if (!node) return;
-    // Recurse left, then right, then delete this node
-    Destroy(node->left);
-    Destroy(node->right);
-    delete node;
+// --- Order statistics ---
+size_t RedBlackTree::SubtreeSize(const RBTNode* node) {
+    return node ? node->size : 0;
 }
 
-void RedBlackTree::Clear() {
-    Destroy(root);
-    root = nullptr;
+/** Recompute a node's subtree size from its children. */
+void RedBlackTree::UpdateSize(RBTNode* node) {
+    node->size = 1 + SubtreeSize(node->left) + SubtreeSize(node->right);
 }
 
 // --- Rotations ---
@@ -73,6 +76,10 @@ void RedBlackTree::LeftRotate(RBTNode* pivot) {
     // Make pivot the left child of its former right child
     child->left = pivot;
     pivot->parent = child;
+
+    // child now roots the whole subtree; pivot lost child's right side
+    child->size = pivot->size;
+    UpdateSize(pivot);
 }
 
 /**
@@ -101,6 +108,10 @@ void RedBlackTree::RightRotate(RBTNode* pivot) {
     // Make pivot the right child of its former left child
     child->right = pivot;
     pivot->parent = child;
+
+    // child now roots the whole subtree; pivot lost child's left side
+    child->size = pivot->size;
+    UpdateSize(pivot);
 }
 
 // --- Insert + Fixup ---
@@ -109,18 +120,22 @@ void RedBlackTree::RightRotate(RBTNode* pivot) {
  *        Duplicate keys replace the stored payload.
  */
 void RedBlackTree::Insert(const Course& course) {
-    RBTNode* newNode = new RBTNode(course);
+    Insert(CourseKey(course.number), course);
+}
+
+void RedBlackTree::Insert(const CourseKey& packed, const Course& course) {
+    SearchKey key{ packed, course.number };
     RBTNode* parentNode = nullptr;
     RBTNode* currentNode = root;
+    int cmp = 0;
 
     // Traverse down the tree like a BST
     while (currentNode != nullptr) {
         parentNode = currentNode;
-        int cmp = CompareKeys(newNode->data.number, currentNode->data.number);
+        cmp = CompareKeys(key, currentNode);
         if (cmp == 0) {
-            // Replace existing course payload if duplicate found
-            currentNode->data = course;
-            delete newNode;
+            // Replace existing course record if duplicate found
+            store.Replace(currentNode->record, course);
             return;
         }
         else if (cmp < 0) {
@@ -131,22 +146,178 @@ void RedBlackTree::Insert(const Course& course) {
         }
     }
 
+    // Only allocate once we know the key is new
+    RBTNode* newNode = nodePool.Allocate(store.Add(packed, course), packed);
+    ++nodeCount;
+
     // Attach new node to parent
     newNode->parent = parentNode;
     if (parentNode == nullptr) {
         root = newNode; // tree was empty
     }
-    else if (CompareKeys(newNode->data.number, parentNode->data.number) < 0) {
+    else if (cmp < 0) {
         parentNode->left = newNode;
     }
     else {
         parentNode->right = newNode;
     }
 
+    // Every ancestor gained one node
+    for (RBTNode* ancestor = parentNode; ancestor; ancestor = ancestor->parent) {
+        ++ancestor->size;
+    }
+
     // Restore red-black invariants
     InsertFixup(newNode);
 }
 
+// --- Bulk build ---
+/**
+ * @brief Sort (only if needed) and de-duplicate, then build a balanced tree
+ *        by splitting at the middle. Nodes and store records are allocated in
+ *        key order, so an in-order walk touches consecutive pool slots and
+ *        reads the store's arenas front to back.
+ */
+void RedBlackTree::BuildFromSorted(vector<Course> courses) {
+    Clear();
+
+    // Pack every key once; sorting and de-duplication compare integers
+    vector<CourseKey> keys;
+    keys.reserve(courses.size());
+    for (const Course& course : courses) keys.emplace_back(course.number);
+    auto compare = [&](size_t a, size_t b) {
+        int cmp = keys[a].Compare(keys[b]);
+        if (cmp != 0 || keys[a].IsInline()) return cmp;
+        return CourseKey::CompareTails(courses[a].number, courses[b].number);
+        };
+
+    bool sorted = true;
+    for (size_t i = 1; i < courses.size() && sorted; ++i) sorted = compare(i - 1, i) <= 0;
+    if (!sorted) {
+        // Sort positions (ties: input position, which keeps the sort
+        // stable), then move records and keys once
+        vector<size_t> order(courses.size());
+        for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+        sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            int cmp = compare(a, b);
+            return cmp != 0 ? cmp < 0 : a < b;
+            });
+        vector<Course> sortedCourses;
+        vector<CourseKey> sortedKeys;
+        sortedCourses.reserve(courses.size());
+        sortedKeys.reserve(courses.size());
+        for (size_t position : order) {
+            sortedCourses.push_back(std::move(courses[position]));
+            sortedKeys.push_back(keys[position]);
+        }
+        courses.swap(sortedCourses);
+        keys.swap(sortedKeys);
+    }
+
+    // Keep the last record of each run of equal keys
+    size_t kept = 0;
+    for (size_t i = 0; i < courses.size(); ++i) {
+        bool lastOfRun = (i + 1 == courses.size()) || compare(i, i + 1) != 0;
+        if (lastOfRun) {
+            if (kept != i) {
+                courses[kept] = std::move(courses[i]);
+                keys[kept] = keys[i];
+            }
+            ++kept;
+        }
+    }
+    courses.resize(kept);
+    keys.resize(kept);
+    if (kept == 0) return;
+
+    size_t textBytes = 0, prerequisiteCount = 0;
+    for (const Course& course : courses) {
+        textBytes += course.number.size() + course.title.size();
+        prerequisiteCount += course.prerequisites.size();
+    }
+    store.Reserve(kept, textBytes, prerequisiteCount);
+
+    vector<uint32_t> records;
+    records.reserve(kept);
+    for (size_t i = 0; i < kept; ++i) records.push_back(store.Add(keys[i], courses[i]));
+    BuildBalanced(records);
+}
+
+/**
+ * @brief Copy the snapshot's records into the store in file order, checking
+ *        on the way that each key is greater than the previous one; the
+ *        snapshot was written from a tree, so it is already sorted and unique.
+ */
+bool RedBlackTree::BuildFromSnapshot(const CatalogSnapshot& snapshot) {
+    Clear();
+
+    size_t count = snapshot.Size();
+    size_t textBytes = 0, prerequisiteCount = 0;
+    for (size_t i = 0; i < count; ++i) {
+        CatalogSnapshot::Record record = snapshot.At(i);
+        textBytes += record.Number().size() + record.Title().size();
+        prerequisiteCount += record.PrerequisiteCount();
+    }
+    store.Reserve(count, textBytes, prerequisiteCount);
+
+    vector<uint32_t> records;
+    vector<string_view> prerequisiteNumbers; // reused for every record
+    records.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        CatalogSnapshot::Record record = snapshot.At(i);
+        CourseKey key(record.Number());
+        if (!records.empty()) {
+            const CourseKey& previous = store.Key(records.back());
+            int cmp = previous.Compare(key);
+            if (cmp == 0 && !key.IsInline()) {
+                cmp = CourseKey::CompareTails(store.Number(records.back()), record.Number());
+            }
+            if (cmp >= 0) {
+                Clear();
+                return false;
+            }
+        }
+
+        prerequisiteNumbers.clear();
+        for (size_t p = 0; p < record.PrerequisiteCount(); ++p) {
+            prerequisiteNumbers.push_back(record.Prerequisite(p));
+        }
+        records.push_back(store.Add(key, record.Number(), record.Title(), prerequisiteNumbers));
+    }
+    BuildBalanced(records);
+    return true;
+}
+
+void RedBlackTree::BuildBalanced(const vector<uint32_t>& records) {
+    if (records.empty()) return;
+
+    // Middle splits keep every null link at depth floor(log2 n) or one above.
+    // Coloring the deepest level red (and the rest black) gives every path
+    // the same black height without any fixup.
+    size_t redDepth = 0;
+    while ((size_t(2) << redDepth) <= records.size()) ++redDepth;
+
+    root = BuildSubtree(records, 0, records.size(), 0, redDepth, nullptr);
+    nodeCount = records.size();
+    root->color = BLACK;
+}
+
+RBTNode* RedBlackTree::BuildSubtree(const vector<uint32_t>& records,
+    size_t lo, size_t hi, size_t depth, size_t redDepth, RBTNode* parentNode) {
+    if (lo >= hi) return nullptr;
+    size_t mid = lo + (hi - lo) / 2;
+
+    RBTNode* leftChild = BuildSubtree(records, lo, mid, depth + 1, redDepth, nullptr);
+    RBTNode* node = nodePool.Allocate(records[mid], store.Key(records[mid]));
+    node->parent = parentNode;
+    node->color = depth == redDepth ? RED : BLACK;
+    node->left = leftChild;
+    if (leftChild) leftChild->parent = node;
+    node->right = BuildSubtree(records, mid + 1, hi, depth + 1, redDepth, node);
+    node->size = hi - lo;
+    return node;
+}
+
 /**
  * @brief Restore red-black invariants after insertion.
  */
@@ -197,64 +368,449 @@ void RedBlackTree::InsertFixup(RBTNode* newNode) {
     if (root) root->color = BLACK; // root must always be black
 }
 
+// --- Erase + Fixup ---
+/**
+ * @brief Put `replacement` (possibly null) where `target` hangs in the tree.
+ */
+void RedBlackTree::Transplant(RBTNode* target, RBTNode* replacement) {
+    if (!target->parent) {
+        root = replacement;
+    }
+    else if (target == target->parent->left) {
+        target->parent->left = replacement;
+    }
+    else {
+        target->parent->right = replacement;
+    }
+    if (replacement) replacement->parent = target->parent;
+}
+
+/**
+ * @brief Remove a node by catalog number. A node with two children is
+ *        replaced by its in-order successor, which is unlinked from its own
+ *        spot (nodes are relinked, not copied, so other nodes stay put).
+ */
+bool RedBlackTree::Erase(string_view courseNumber) {
+    SearchKey key = MakeSearchKey(courseNumber);
+    RBTNode* target = root;
+    while (target) {
+        int cmp = CompareKeys(key, target);
+        if (cmp == 0) break;
+        target = cmp < 0 ? target->left : target->right;
+    }
+    if (!target) return false;
+
+    // The node that leaves its position: target itself, or its successor
+    RBTNode* removed = target;
+    if (target->left && target->right) {
+        removed = target->right;
+        while (removed->left) removed = removed->left;
+    }
+
+    // Every ancestor of that position loses one node (target included when
+    // the successor moves up, so its size is already right for the successor)
+    for (RBTNode* ancestor = removed->parent; ancestor; ancestor = ancestor->parent) {
+        --ancestor->size;
+    }
+
+    Color removedColor = removed->color;
+    RBTNode* child;       // takes over the removed position; may be null
+    RBTNode* childParent; // its parent after the unlink
+
+    if (!target->left) {
+        child = target->right;
+        childParent = target->parent;
+        Transplant(target, target->right);
+    }
+    else if (!target->right) {
+        child = target->left;
+        childParent = target->parent;
+        Transplant(target, target->left);
+    }
+    else {
+        child = removed->right;
+        if (removed->parent == target) {
+            childParent = removed;
+        }
+        else {
+            childParent = removed->parent;
+            Transplant(removed, removed->right);
+            removed->right = target->right;
+            removed->right->parent = removed;
+        }
+        Transplant(target, removed);
+        removed->left = target->left;
+        removed->left->parent = removed;
+        removed->color = target->color;
+        removed->size = target->size;
+    }
+
+    store.Remove(target->record);
+    nodePool.Release(target);
+    --nodeCount;
+
+    // Losing a black node leaves one path short; repair from the child up
+    if (removedColor == BLACK) EraseFixup(child, childParent);
+    return true;
+}
+
+/**
+ * @brief Restore red-black invariants after erasing a black node. `node`
+ *        carries an extra black and may be null, so its parent is passed too.
+ */
+void RedBlackTree::EraseFixup(RBTNode* node, RBTNode* parentNode) {
+    auto isBlack = [](const RBTNode* n) { return !n || n->color == BLACK; };
+
+    while (node != root && isBlack(node)) {
+        if (node == parentNode->left) {
+            RBTNode* sibling = parentNode->right;
+            if (sibling->color == RED) {
+                // Red sibling: rotate so the sibling is black
+                sibling->color = BLACK;
+                parentNode->color = RED;
+                LeftRotate(parentNode);
+                sibling = parentNode->right;
+            }
+            if (isBlack(sibling->left) && isBlack(sibling->right)) {
+                // Push the extra black up
+                sibling->color = RED;
+                node = parentNode;
+                parentNode = node->parent;
+            }
+            else {
+                if (isBlack(sibling->right)) {
+                    sibling->left->color = BLACK;
+                    sibling->color = RED;
+                    RightRotate(sibling);
+                    sibling = parentNode->right;
+                }
+                sibling->color = parentNode->color;
+                parentNode->color = BLACK;
+                sibling->right->color = BLACK;
+                LeftRotate(parentNode);
+                node = root;
+            }
+        }
+        else {
+            // Mirror logic when node is a right child
+            RBTNode* sibling = parentNode->left;
+            if (sibling->color == RED) {
+                sibling->color = BLACK;
+                parentNode->color = RED;
+                RightRotate(parentNode);
+                sibling = parentNode->left;
+            }
+            if (isBlack(sibling->left) && isBlack(sibling->right)) {
+                sibling->color = RED;
+                node = parentNode;
+                parentNode = node->parent;
+            }
+            else {
+                if (isBlack(sibling->left)) {
+                    sibling->right->color = BLACK;
+                    sibling->color = RED;
+                    LeftRotate(sibling);
+                    sibling = parentNode->left;
+                }
+                sibling->color = parentNode->color;
+                parentNode->color = BLACK;
+                sibling->left->color = BLACK;
+                RightRotate(parentNode);
+                node = root;
+            }
+        }
+    }
+    if (node) node->color = BLACK;
+}
+
+size_t RedBlackTree::ApplyChanges(const vector<Course>& adds, const vector<string>& removes) {
+    size_t removedCount = 0;
+    for (const string& courseNumber : removes) {
+        if (Erase(courseNumber)) ++removedCount;
+    }
+    for (const Course& course : adds) Insert(course);
+    return removedCount;
+}
+
 // --- Search ---
 /**
  * @brief Case-insensitive search for a Course by catalog number.
  */
 Course RedBlackTree::Search(string courseNumber) const {
-    courseNumber = ToUpperCopy(courseNumber);
+    CourseView found = Find(courseNumber);
+    return found ? found.ToCourse() : Course(); // default Course when not found
+}
+
+/**
+ * @brief Case-insensitive lookup returning a view of the stored course.
+ */
+CourseView RedBlackTree::Find(string_view courseNumber) const {
+    SearchKey key = MakeSearchKey(courseNumber);
     RBTNode* currentNode = root;
 
 	// Standard BST search but no recursive calls
     while (currentNode) {
-        string curKey = ToUpperCopy(currentNode->data.number);
-        if (courseNumber == curKey) {
-            return currentNode->data;
+        int cmp = CompareKeys(key, currentNode);
+        if (cmp == 0) {
+            return store.View(currentNode->record);
         }
-        else if (courseNumber < curKey) {
+        else if (cmp < 0) {
             currentNode = currentNode->left;
         }
         else {
             currentNode = currentNode->right;
         }
     }
-    return Course(); // not found
+    return CourseView(); // not found
 }
 
-// --- Print ---
 /**
- * @brief Recursive in-order traversal that prints "NUMBER, TITLE".
+ * @brief Interleaved descents: each round advances every unfinished cursor of
+ *        the group by one level and prefetches the node it lands on.
  */
-void RedBlackTree::InOrderPrint(RBTNode* node) const {
-    if (!node) return;
-    InOrderPrint(node->left);
-    cout << node->data.number << ", " << node->data.title << endl;
-    InOrderPrint(node->right);
+void RedBlackTree::SearchMany(const vector<string_view>& keys, vector<CourseView>& out) const {
+    out.assign(keys.size(), CourseView());
+    const RBTNode* cursors[BATCH_WIDTH];
+    SearchKey groupKeys[BATCH_WIDTH];
+
+    for (size_t base = 0; base < keys.size(); base += BATCH_WIDTH) {
+        size_t groupSize = min(BATCH_WIDTH, keys.size() - base);
+        for (size_t i = 0; i < groupSize; ++i) {
+            cursors[i] = root;
+            groupKeys[i] = MakeSearchKey(keys[base + i]);
+        }
+
+        size_t active = groupSize;
+        while (active > 0) {
+            active = 0;
+            for (size_t i = 0; i < groupSize; ++i) {
+                const RBTNode* node = cursors[i];
+                if (!node) continue;
+
+                int cmp = CompareKeys(groupKeys[i], node);
+                if (cmp == 0) {
+                    out[base + i] = store.View(node->record);
+                    cursors[i] = nullptr;
+                    continue;
+                }
+                node = cmp < 0 ? node->left : node->right;
+                cursors[i] = node;
+                if (node) {
+                    PrefetchRead(node);
+                    ++active;
+                }
+            }
+        }
+    }
 }
 
-void RedBlackTree::PrintAll() const {
-    InOrderPrint(root);
+// --- Bounds ---
+/**
+ * @brief Descend once, remembering the last node whose key is >= the target.
+ */
+RedBlackTree::Iterator RedBlackTree::LowerBound(string_view courseNumber) const {
+    SearchKey key = MakeSearchKey(courseNumber);
+    const RBTNode* candidate = nullptr;
+    const RBTNode* currentNode = root;
+    while (currentNode) {
+        if (CompareKeys(key, currentNode) <= 0) {
+            candidate = currentNode;
+            currentNode = currentNode->left;
+        }
+        else {
+            currentNode = currentNode->right;
+        }
+    }
+    return Iterator(candidate, this);
+}
+
+/**
+ * @brief Descend once, remembering the last node whose key is > the target.
+ */
+RedBlackTree::Iterator RedBlackTree::UpperBound(string_view courseNumber) const {
+    SearchKey key = MakeSearchKey(courseNumber);
+    const RBTNode* candidate = nullptr;
+    const RBTNode* currentNode = root;
+    while (currentNode) {
+        if (CompareKeys(key, currentNode) < 0) {
+            candidate = currentNode;
+            currentNode = currentNode->left;
+        }
+        else {
+            currentNode = currentNode->right;
+        }
+    }
+    return Iterator(candidate, this);
+}
+
+pair<RedBlackTree::Iterator, RedBlackTree::Iterator> RedBlackTree::EqualRange(string_view courseNumber) const {
+    Iterator first = LowerBound(courseNumber);
+    Iterator last = first;
+    if (first != end() && CourseKeyEquals(first->number, courseNumber)) ++last;
+    return { first, last };
+}
+
+// --- Range queries ---
+size_t RedBlackTree::RangeQuery(string_view lo, string_view hi,
+    const function<void(const CourseView&)>& visitor) const {
+    size_t visited = 0;
+    for (Iterator it = LowerBound(lo); it != end(); ++it) {
+        // Stop past hi; an inverted range (lo > hi) stops at its first course
+        CourseView course = *it;
+        if (CompareCourseKeys(course.number, hi) > 0) break;
+        visitor(course);
+        ++visited;
+    }
+    return visited;
+}
+
+/**
+ * @brief All keys sharing a prefix are contiguous in key order, starting at
+ *        LowerBound(prefix); walk forward until the prefix no longer matches.
+ */
+size_t RedBlackTree::PrefixQuery(string_view prefix, const function<void(const CourseView&)>& visitor) const {
+    size_t visited = 0;
+    for (Iterator it = LowerBound(prefix); it != end(); ++it) {
+        CourseView course = *it;
+        string_view number = course.number;
+        if (number.size() < prefix.size() || !CourseKeyEquals(number.substr(0, prefix.size()), prefix)) break;
+        visitor(course);
+        ++visited;
+    }
+    return visited;
+}
+
+// --- Rank / Select ---
+/**
+ * @brief Descend toward the key; every step right skips the current node and
+ *        its whole left subtree, all of which sort before the key.
+ */
+size_t RedBlackTree::Rank(string_view courseNumber) const {
+    SearchKey key = MakeSearchKey(courseNumber);
+    size_t rank = 0;
+    const RBTNode* currentNode = root;
+    while (currentNode) {
+        int cmp = CompareKeys(key, currentNode);
+        if (cmp <= 0) {
+            if (cmp == 0) return rank + SubtreeSize(currentNode->left);
+            currentNode = currentNode->left;
+        }
+        else {
+            rank += SubtreeSize(currentNode->left) + 1;
+            currentNode = currentNode->right;
+        }
+    }
+    return rank;
+}
+
+/**
+ * @brief Descend by subtree sizes: the left subtree holds positions below the
+ *        node's own, the right subtree those above it.
+ */
+RedBlackTree::Iterator RedBlackTree::Select(size_t index) const {
+    if (index >= nodeCount) return end();
+    const RBTNode* currentNode = root;
+    while (currentNode) {
+        size_t leftSize = SubtreeSize(currentNode->left);
+        if (index < leftSize) {
+            currentNode = currentNode->left;
+        }
+        else if (index == leftSize) {
+            break;
+        }
+        else {
+            index -= leftSize + 1;
+            currentNode = currentNode->right;
+        }
+    }
+    return Iterator(currentNode, this);
+}
+
+// --- Iteration ---
+const RBTNode* RedBlackTree::Minimum(const RBTNode* node) {
+    while (node && node->left) node = node->left;
+    return node;
+}
+
+const RBTNode* RedBlackTree::Maximum(const RBTNode* node) {
+    while (node && node->right) node = node->right;
+    return node;
+}
+
+/**
+ * @brief In-order successor via parent links; nullptr after the largest key.
+ */
+const RBTNode* RedBlackTree::Successor(const RBTNode* node) {
+    if (node->right) return Minimum(node->right);
+    const RBTNode* parentNode = node->parent;
+    while (parentNode && node == parentNode->right) {
+        node = parentNode;
+        parentNode = parentNode->parent;
+    }
+    return parentNode;
+}
+
+/**
+ * @brief In-order predecessor via parent links; nullptr before the smallest key.
+ */
+const RBTNode* RedBlackTree::Predecessor(const RBTNode* node) {
+    if (node->left) return Maximum(node->left);
+    const RBTNode* parentNode = node->parent;
+    while (parentNode && node == parentNode->left) {
+        node = parentNode;
+        parentNode = parentNode->parent;
+    }
+    return parentNode;
+}
+
+RedBlackTree::Iterator& RedBlackTree::Iterator::operator++() {
+    node = Successor(node);
+    return *this;
+}
+
+RedBlackTree::Iterator& RedBlackTree::Iterator::operator--() {
+    node = node ? Predecessor(node) : Maximum(tree->root);
+    return *this;
 }
 
-void RedBlackTree::ForEach(const function<void(const Course&)>& fn) const {
-    InOrderApply(root, fn);
+RedBlackTree::Iterator RedBlackTree::begin() const {
+    return Iterator(Minimum(root), this);
 }
 
-void RedBlackTree::InOrderApply(RBTNode* node, const function<void(const Course&)>& fn) const {
-    if (!node) return;
-    InOrderApply(node->left, fn);
-    fn(node->data);
-    InOrderApply(node->right, fn);
+RedBlackTree::Iterator RedBlackTree::end() const {
+    return Iterator(nullptr, this);
+}
+
+// --- Print ---
+/**
+ * @brief In-order traversal that prints "NUMBER, TITLE".
+ */
+void RedBlackTree::PrintAll() const {
+    for (CourseView course : *this) {
+        cout << course.number << ", " << course.title << endl;
+    }
 }
 
 /**
- * @brief Recursively count nodes in a subtree.
+ * @brief Seek to the page start in O(log n), then print by successor steps.
  */
-size_t RedBlackTree::CountNodes(RBTNode* node) const {
-    if (!node) return 0;
-    return 1 + CountNodes(node->left) + CountNodes(node->right);
+size_t RedBlackTree::PrintPage(size_t first, size_t count) const {
+    size_t printed = 0;
+    for (Iterator it = Select(first); it != end() && printed < count; ++it, ++printed) {
+        CourseView course = *it;
+        cout << course.number << ", " << course.title << endl;
+    }
+    return printed;
+}
+
+void RedBlackTree::ForEach(const function<void(const CourseView&)>& fn) const {
+    for (CourseView course : *this) fn(course);
 }
 
 size_t RedBlackTree::Size() const {
-    return CountNodes(root);
+    return nodeCount;
+}
+
+size_t RedBlackTree::MemoryBytes() const {
+    return nodeCount * sizeof(RBTNode) + store.MemoryBytes();
 }
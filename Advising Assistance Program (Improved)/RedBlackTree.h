@@ -1,81 +1,306 @@
 #pragma once
 
+#include <cstdint>
+#include <iterator>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <functional>
+#include <utility>
 #include "Course.h"
+#include "CatalogStore.h"
+#include "CourseKey.h"
+#include "SlabPool.h"
+
+class CatalogSnapshot;
 
 enum Color { RED, BLACK };
 
 /**
  * @brief Node type for the red-black tree.
  *
- * Each node stores a Course and the metadata/links needed for balancing.
+ * Each node holds the ID of its course in the tree's CatalogStore and the
+ * metadata/links needed for balancing. `key` is the course number packed
+ * into two words (see CourseKey), so a descent compares integers only; the
+ * number text in the store is read just to break a tie between two keys
+ * longer than CourseKey::INLINE_BYTES.
+ * `size` counts the nodes of the subtree rooted here (order statistics).
  */
 struct RBTNode {
-    Course data;     // The stored course record.
-    Color color;     // Node color (red or black).
-    RBTNode* parent; // Parent pointer.
-    RBTNode* left;   // Left child pointer.
-    RBTNode* right;  // Right child pointer.
-
-    explicit RBTNode(const Course& c)
-        : data(c), color(RED), parent(nullptr), left(nullptr), right(nullptr) {
-    }
+    uint32_t record;  // The stored course's ID in the tree's CatalogStore.
+    Color color;      // Node color (red or black); shares a word with record.
+    CourseKey key;    // Packed, folded course number.
+    RBTNode* parent;  // Parent pointer.
+    RBTNode* left;    // Left child pointer.
+    RBTNode* right;   // Right child pointer.
+    size_t size;      // Nodes in this subtree, including this one.
+
+    RBTNode(uint32_t record, const CourseKey& key);
 };
 
 /**
  * @brief Balanced binary search tree (red-black) keyed by Course::number.
+ *
+ * Course records live in a CatalogStore owned by the tree and nodes refer to
+ * them by ID; lookups and iteration yield CourseViews into the store.
+ *
+ * Nodes are carved from a slab pool owned by the tree, so nodes inserted
+ * together are adjacent in memory and Clear releases them all with one
+ * linear sweep instead of a recursive walk with a delete per node.
+ *
+ * Every node also tracks its subtree size, maintained through inserts and
+ * rotations, so positional queries (Rank/Select) run in O(log n).
  */
 class RedBlackTree {
 public:
+    /**
+     * @brief Bidirectional in-order iterator over the stored courses.
+     *        Dereferencing yields a CourseView by value.
+     *
+     * Steps follow parent links, so traversal needs no recursion or stack.
+     * The past-the-end iterator holds a null node; decrementing it yields the
+     * largest key. Iterators stay valid until their node is removed or the
+     * tree is cleared.
+     */
+    class Iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        /** Keeps the view that operator-> points into alive for the expression. */
+        struct ArrowProxy {
+            CourseView view;
+            const CourseView* operator->() const { return &view; }
+        };
+
+        using value_type = CourseView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = ArrowProxy;
+        using reference = CourseView;
+
+        Iterator() : node(nullptr), tree(nullptr) {}
+
+        reference operator*() const { return tree->store.View(node->record); }
+        pointer operator->() const { return ArrowProxy{ **this }; }
+
+        Iterator& operator++();
+        Iterator operator++(int) { Iterator prev = *this; ++*this; return prev; }
+        Iterator& operator--();
+        Iterator operator--(int) { Iterator prev = *this; --*this; return prev; }
+
+        bool operator==(const Iterator& other) const { return node == other.node; }
+        bool operator!=(const Iterator& other) const { return node != other.node; }
+
+    private:
+        friend class RedBlackTree;
+        Iterator(const RBTNode* n, const RedBlackTree* t) : node(n), tree(t) {}
+
+        const RBTNode* node;
+        const RedBlackTree* tree;
+    };
+
     RedBlackTree();
     ~RedBlackTree();
 
+    RedBlackTree(const RedBlackTree&) = delete;
+    RedBlackTree& operator=(const RedBlackTree&) = delete;
+
     /**
      * @brief Insert a course keyed by its catalog number.
      *        If the number already exists, replaces the stored Course.
      */
     void Insert(const Course& course);
 
+    /**
+     * @brief Insert with the key already packed, e.g. by the loader while the
+     *        number token is in cache. `key` must be CourseKey(course.number).
+     */
+    void Insert(const CourseKey& key, const Course& course);
+
+    /**
+     * @brief Replace the contents with `courses` in O(n) without rotations.
+     *        Input already in key order (case-insensitive) is used as is;
+     *        otherwise it is sorted first. Duplicate keys resolve last-wins,
+     *        matching repeated Insert calls.
+     * @param courses Records to store; consumed by the build.
+     */
+    void BuildFromSorted(std::vector<Course> courses);
+
+    /**
+     * @brief Replace the contents with the records of an open snapshot in
+     *        O(n). Fields are copied from the mapping straight into the
+     *        store (no Course per record) and the snapshot's order is used
+     *        as is, without sorting.
+     * @return False, leaving the tree empty, if the records are not in
+     *         strictly ascending key order.
+     */
+    bool BuildFromSnapshot(const CatalogSnapshot& snapshot);
+
+    /**
+     * @brief Remove a course by catalog number (case-insensitive), then
+     *        restore the red-black invariants. O(log n).
+     * @return True if a course was removed.
+     */
+    bool Erase(std::string_view courseNumber);
+
+    /**
+     * @brief Apply a term update in place: erase `removes`, then upsert `adds`.
+     *        Only the affected nodes are touched; a course listed in both ends
+     *        up present with its new record.
+     * @return Number of removals that matched a stored course.
+     */
+    size_t ApplyChanges(const std::vector<Course>& adds, const std::vector<std::string>& removes);
+
     /**
      * @brief Search for a course by catalog number (case-insensitive).
      * @param courseNumber Catalog key to look up.
-     * @return Matching Course if found, otherwise a default Course.
+     * @return Owning copy of the match if found, otherwise a default Course.
      */
     Course Search(std::string courseNumber) const;
 
+    /**
+     * @brief Zero-copy lookup by catalog number (case-insensitive).
+     *        Performs no allocation; keys are compared in place.
+     * @param courseNumber Catalog key to look up.
+     * @return View of the stored course, or an empty (false) view if not
+     *         found. The view is invalidated by the next Insert, Erase or Clear.
+     */
+    CourseView Find(std::string_view courseNumber) const;
+
+    /**
+     * @brief Batched zero-copy lookup. Up to BATCH_WIDTH descents advance in
+     *        lockstep, one level per round, and each step prefetches the child
+     *        it moves to, so the node misses of different keys overlap.
+     * @param keys Catalog keys to find (case-insensitive).
+     * @param out  Resized to keys.size(); out[i] is the match for keys[i] or an empty view.
+     */
+    void SearchMany(const std::vector<std::string_view>& keys, std::vector<CourseView>& out) const;
+
+    /** Number of descents interleaved by SearchMany. */
+    static constexpr size_t BATCH_WIDTH = 8;
+
     /**
      * @brief Print all courses in ascending order:
      */
     void PrintAll() const;
 
-    /** @brief Remove all nodes from the tree. */
+    /** @brief Remove all nodes from the tree. Node memory is kept for reuse. */
     void Clear();
 
     /**
-     * @brief Apply a function to each Course in ascending order.
-     * @param fn Callback invoked with each Course.
+     * @brief Apply a function to each course in ascending order.
+     * @param fn Callback invoked with a view of each course.
      */
-    void ForEach(const std::function<void(const Course&)>& fn) const;
+    void ForEach(const std::function<void(const CourseView&)>& fn) const;
 
-    /** @return Number of nodes currently in the tree. */
+    /** @return Number of nodes currently in the tree (maintained, O(1)). */
     size_t Size() const;
 
+    /** @return Bytes held by live nodes and the record store (capacity). */
+    size_t MemoryBytes() const;
+
+    /**
+     * @return The store that node records live in. CourseView::record values
+     *         from this tree are IDs in it, so secondary indexes (see
+     *         DepartmentIndex) can keep IDs instead of copies.
+     */
+    const CatalogStore& Store() const { return store; }
+
+    /** @return Iterator to the smallest key. */
+    Iterator begin() const;
+
+    /** @return Past-the-end iterator. */
+    Iterator end() const;
+
+    /**
+     * @brief First course whose key is not less than `courseNumber`
+     *        (case-insensitive). O(log n).
+     */
+    Iterator LowerBound(std::string_view courseNumber) const;
+
+    /**
+     * @brief First course whose key is greater than `courseNumber`
+     *        (case-insensitive). O(log n).
+     */
+    Iterator UpperBound(std::string_view courseNumber) const;
+
+    /**
+     * @brief Range of courses equal to `courseNumber`: empty, or exactly one
+     *        course since keys are unique.
+     */
+    std::pair<Iterator, Iterator> EqualRange(std::string_view courseNumber) const;
+
+    /**
+     * @brief Visit every course with lo <= key <= hi (case-insensitive) in
+     *        ascending order. Seeks to lo and stops past hi: O(log n + k).
+     * @return Number of courses visited.
+     */
+    size_t RangeQuery(std::string_view lo, std::string_view hi,
+        const std::function<void(const CourseView&)>& visitor) const;
+
+    /**
+     * @brief Visit every course whose key starts with `prefix`
+     *        (case-insensitive, e.g. "cs2") in ascending order. O(log n + k).
+     * @return Number of courses visited.
+     */
+    size_t PrefixQuery(std::string_view prefix, const std::function<void(const CourseView&)>& visitor) const;
+
+    /**
+     * @brief Number of courses whose key sorts before `courseNumber`
+     *        (case-insensitive). The key itself need not be stored. O(log n).
+     */
+    size_t Rank(std::string_view courseNumber) const;
+
+    /**
+     * @brief Course at zero-based position `index` in ascending key order. O(log n).
+     * @return Iterator to that course, or end() if index >= Size().
+     */
+    Iterator Select(size_t index) const;
+
+    /**
+     * @brief Print `count` courses in ascending order starting at position
+     *        `first`. Seeks with Select instead of walking from the smallest key.
+     * @return Number of courses printed.
+     */
+    size_t PrintPage(size_t first, size_t count) const;
+
 private:
     RBTNode* root;
+    size_t nodeCount;
+    CatalogStore store;         // every course record, addressed by RBTNode::record
+    SlabPool<RBTNode> nodePool; // owns every node reachable from root
 
     // Rotations and balancing
     void LeftRotate(RBTNode* pivot);
     void RightRotate(RBTNode* pivot);
     void InsertFixup(RBTNode* newNode);
+    void EraseFixup(RBTNode* node, RBTNode* parentNode);
+    void Transplant(RBTNode* target, RBTNode* replacement);
+
+    // Shared tail of the bulk builds: a balanced tree over store records
+    // already in ascending key order
+    void BuildBalanced(const std::vector<uint32_t>& records);
+
+    // Recursive step of BuildBalanced: subtree over records[lo, hi)
+    RBTNode* BuildSubtree(const std::vector<uint32_t>& records,
+        size_t lo, size_t hi, size_t depth, size_t redDepth, RBTNode* parentNode);
+
+    // Order-statistic helpers
+    static size_t SubtreeSize(const RBTNode* node);
+    static void UpdateSize(RBTNode* node);
+
+    // Navigation helpers used by Iterator
+    static const RBTNode* Minimum(const RBTNode* node);
+    static const RBTNode* Maximum(const RBTNode* node);
+    static const RBTNode* Successor(const RBTNode* node);
+    static const RBTNode* Predecessor(const RBTNode* node);
 
-    // Utility methods
-    void InOrderPrint(RBTNode* node) const;
-    void Destroy(RBTNode* node);
-    void InOrderApply(RBTNode* node, const std::function<void(const Course&)>& fn) const;
-    size_t CountNodes(RBTNode* node) const;
+    // A lookup key normalized once per operation: packed key + raw text
+    // (the text is only read to settle ties between oversized keys).
+    struct SearchKey {
+        CourseKey packed;
+        std::string_view text;
+    };
+    static SearchKey MakeSearchKey(std::string_view key);
 
-    // Compare two keys case-insensitively.
-    static int CompareKeys(const std::string& a, const std::string& b);
+    // Compare a search key with a node's key; never allocates.
+    int CompareKeys(const SearchKey& key, const RBTNode* node) const;
 };
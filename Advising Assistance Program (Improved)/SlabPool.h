@@ -0,0 +1,118 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+/**
+ * @file SlabPool.h
+ * @brief Fixed-size object pool that carves objects out of large slabs.
+ *
+ * Objects are constructed in place inside slabs of SLAB_OBJECTS slots, so
+ * objects allocated together sit next to each other in memory instead of
+ * being scattered across the heap. Released slots go on a free list and are
+ * reused by the next Allocate; a released slot's own storage holds the link.
+ * ReleaseAll destroys every live object with a linear sweep over the slabs
+ * (no pointer chasing, no per-object free) and keeps the slabs for the next
+ * round of allocations.
+ *
+ * The pool owns its objects; it is not copyable.
+ */
+template <typename T, size_t SLAB_OBJECTS = 512>
+class SlabPool {
+public:
+    SlabPool() : freeList(nullptr), usedInLast(SLAB_OBJECTS), liveCount(0), activeSlabs(0) {}
+
+    ~SlabPool() {
+        ReleaseAll();
+        for (T* slab : slabs) ::operator delete(slab);
+    }
+
+    SlabPool(const SlabPool&) = delete;
+    SlabPool& operator=(const SlabPool&) = delete;
+
+    /**
+     * @brief Construct a T in a free slot.
+     * @param args Constructor arguments forwarded to T.
+     * @return Pointer to the new object, owned by the pool.
+     */
+    template <typename... Args>
+    T* Allocate(Args&&... args) {
+        void* slot;
+        if (freeList) {
+            slot = freeList;
+            freeList = freeList->next;
+        }
+        else {
+            if (usedInLast == SLAB_OBJECTS) AddSlab();
+            slot = slabs[activeSlabs - 1] + usedInLast++;
+        }
+        ++liveCount;
+        return new (slot) T(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Destroy an object and return its slot to the free list.
+     * @param object Pointer previously returned by Allocate.
+     */
+    void Release(T* object) {
+        object->~T();
+        FreeSlot* link = new (static_cast<void*>(object)) FreeSlot;
+        link->next = freeList;
+        freeList = link;
+        --liveCount;
+    }
+
+    /**
+     * @brief Destroy every live object. Slab memory is kept for reuse.
+     */
+    void ReleaseAll() {
+        // Slots on the free list hold links, not objects; skip them in the sweep
+        std::vector<const void*> freeSlots;
+        for (FreeSlot* link = freeList; link; link = link->next) freeSlots.push_back(link);
+        std::sort(freeSlots.begin(), freeSlots.end());
+
+        for (size_t s = 0; s < activeSlabs; ++s) {
+            size_t used = (s + 1 == activeSlabs) ? usedInLast : SLAB_OBJECTS;
+            for (size_t i = 0; i < used; ++i) {
+                T* object = slabs[s] + i;
+                if (!freeSlots.empty() && std::binary_search(freeSlots.begin(), freeSlots.end(),
+                    static_cast<const void*>(object))) {
+                    continue;
+                }
+                object->~T();
+            }
+        }
+        freeList = nullptr;
+        usedInLast = SLAB_OBJECTS;
+        liveCount = 0;
+        activeSlabs = 0;
+    }
+
+    /** @return Number of live objects. */
+    size_t Size() const { return liveCount; }
+
+private:
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+
+    static_assert(sizeof(T) >= sizeof(FreeSlot), "slot too small to hold a free-list link");
+
+    std::vector<T*> slabs;     // allocated slabs of SLAB_OBJECTS slots; the first activeSlabs are in use
+    FreeSlot* freeList;        // released slots available for reuse
+    size_t usedInLast;         // slots handed out from the newest active slab
+    size_t liveCount;          // constructed objects
+    size_t activeSlabs;        // slabs currently handing out slots
+
+    /** Activate a retained slab or allocate a new one. */
+    void AddSlab() {
+        if (activeSlabs == slabs.size()) {
+            slabs.push_back(static_cast<T*>(::operator new(sizeof(T) * SLAB_OBJECTS)));
+        }
+        ++activeSlabs;
+        usedInLast = 0;
+    }
+};
@@ -0,0 +1,129 @@
+#include "StaticIndex.h"
+#include "Prefetch.h"
+using namespace std;
+
+StaticIndex::StaticIndex() {}
+
+// --- Build ---
+/**
+ * @brief Copy keys and records out of the tree in order, then lay the heads
+ *        out in Eytzinger order.
+ */
+void StaticIndex::Build(const RedBlackTree& tree) {
+    Clear();
+    size_t n = tree.Size();
+    records.reserve(n);
+    keyOffsets.reserve(n + 1);
+
+    for (CourseView course : tree) {
+        keyOffsets.push_back(static_cast<uint32_t>(keyText.size()));
+        for (char ch : course.number) keyText.push_back(FoldKeyChar(ch));
+        records.push_back(course.ToCourse());
+    }
+    keyOffsets.push_back(static_cast<uint32_t>(keyText.size()));
+
+    heads.assign(n + 1, 0);
+    ranks.assign(n + 1, 0);
+    size_t nextPosition = 0;
+    Layout(1, nextPosition);
+}
+
+void StaticIndex::Build(vector<Course> courses) {
+    // The tree's bulk build sorts and de-duplicates with the same rules
+    RedBlackTree tree;
+    tree.BuildFromSorted(std::move(courses));
+    Build(tree);
+}
+
+/**
+ * @brief In-order walk of the implicit tree (children of k at 2k, 2k+1)
+ *        assigns sorted positions to slots.
+ */
+void StaticIndex::Layout(size_t slot, size_t& nextPosition) {
+    if (slot >= heads.size()) return;
+    Layout(2 * slot, nextPosition);
+    heads[slot] = PackCourseKeyHead(KeyAt(nextPosition));
+    ranks[slot] = static_cast<uint32_t>(nextPosition);
+    ++nextPosition;
+    Layout(2 * slot + 1, nextPosition);
+}
+
+string_view StaticIndex::KeyAt(size_t position) const {
+    return string_view(keyText).substr(keyOffsets[position], keyOffsets[position + 1] - keyOffsets[position]);
+}
+
+// --- Lookups ---
+/**
+ * @brief Branch-free descent: each level adds "slot key < target" to 2k.
+ *        Heads decide almost every step; only equal heads compare key text.
+ *        When the walk falls off the tree, the last left turn is the answer:
+ *        strip the trailing right turns (1 bits) and that turn itself.
+ */
+size_t StaticIndex::LowerBound(string_view courseNumber) const {
+    uint64_t head = PackCourseKeyHead(courseNumber);
+    size_t slotCount = heads.size();
+    size_t slot = 1;
+    while (slot < slotCount) {
+        size_t ahead = slot * PREFETCH_STRIDE;
+        if (ahead < slotCount) PrefetchRead(&heads[ahead]);
+
+        uint64_t slotHead = heads[slot];
+        size_t less = slotHead < head;
+        if (slotHead == head) {
+            // Rare and predictable: equal heads need the key text
+            less = CompareCourseKeys(KeyAt(ranks[slot]), courseNumber) < 0;
+        }
+        slot = 2 * slot + less;
+    }
+
+    while (slot & 1) slot >>= 1;
+    slot >>= 1;
+    return slot == 0 ? records.size() : ranks[slot];
+}
+
+const Course* StaticIndex::Find(string_view courseNumber) const {
+    size_t position = LowerBound(courseNumber);
+    if (position == records.size() || !CourseKeyEquals(KeyAt(position), courseNumber)) return nullptr;
+    return &records[position];
+}
+
+Course StaticIndex::Search(string courseNumber) const {
+    const Course* found = Find(courseNumber);
+    return found ? *found : Course();
+}
+
+const Course& StaticIndex::At(size_t position) const {
+    return records[position];
+}
+
+/**
+ * @brief Keys sharing a prefix are contiguous in sorted order; scan the key
+ *        text from the lower bound until the prefix stops matching.
+ */
+size_t StaticIndex::PrefixQuery(string_view prefix, const function<void(const Course&)>& visitor) const {
+    size_t visited = 0;
+    for (size_t position = LowerBound(prefix); position < records.size(); ++position) {
+        string_view key = KeyAt(position);
+        if (key.size() < prefix.size() || !CourseKeyEquals(key.substr(0, prefix.size()), prefix)) break;
+        visitor(records[position]);
+        ++visited;
+    }
+    return visited;
+}
+
+// --- Iteration ---
+void StaticIndex::ForEach(const function<void(const Course&)>& fn) const {
+    for (const Course& c : records) fn(c);
+}
+
+size_t StaticIndex::Size() const {
+    return records.size();
+}
+
+void StaticIndex::Clear() {
+    heads.clear();
+    ranks.clear();
+    keyText.clear();
+    keyOffsets.clear();
+    records.clear();
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <functional>
+#include "Course.h"
+#include "RedBlackTree.h"
+
+/**
+ * @file StaticIndex.h
+ * @brief Read-only ordered course index in a contiguous Eytzinger layout.
+ *
+ * For the serving phase the ordered catalog is frozen out of a RedBlackTree
+ * into flat arrays. Keys and payload are stored apart:
+ *  - `heads` holds each key's packed 8-byte head (see PackCourseKeyHead) in
+ *    Eytzinger (BFS) order, so a search reads one 8-byte word per level and
+ *    the top levels share a few cache lines. Children of slot k sit at 2k
+ *    and 2k+1, so the search prefetches the slots several levels below.
+ *  - `ranks` maps an Eytzinger slot to the key's position in sorted order;
+ *    it is read only when two heads tie.
+ *  - The folded key text and the Course records are stored in sorted
+ *    order, so a prefix query is a lower_bound followed by a linear scan.
+ *
+ * Lookups use the same case-insensitive semantics as the other indexes.
+ */
+class StaticIndex {
+public:
+    StaticIndex();
+
+    /** @brief Freeze the contents of a tree (already sorted and unique). */
+    void Build(const RedBlackTree& tree);
+
+    /**
+     * @brief Build from a list of courses. Duplicate keys (case-insensitive)
+     *        resolve last-wins, as for RedBlackTree::BuildFromSorted.
+     * @param courses Records to index; consumed by the build.
+     */
+    void Build(std::vector<Course> courses);
+
+    /**
+     * @brief Zero-copy exact lookup by catalog number (case-insensitive).
+     * @return Pointer to the stored Course, or nullptr if not found.
+     */
+    const Course* Find(std::string_view courseNumber) const;
+
+    /**
+     * @brief Lookup returning a copy, mirroring the other indexes' Search.
+     * @return Matching Course, or a default-constructed Course if not found.
+     */
+    Course Search(std::string courseNumber) const;
+
+    /**
+     * @brief Sorted position of the first course whose key is not less than
+     *        `courseNumber` (case-insensitive).
+     * @return Position in [0, Size()]; Size() if every key is smaller.
+     */
+    size_t LowerBound(std::string_view courseNumber) const;
+
+    /** @return Course at a sorted position (must be < Size()). */
+    const Course& At(size_t position) const;
+
+    /**
+     * @brief Visit every course whose key starts with `prefix`
+     *        (case-insensitive) in ascending order. O(log n + k).
+     * @return Number of courses visited.
+     */
+    size_t PrefixQuery(std::string_view prefix, const std::function<void(const Course&)>& visitor) const;
+
+    /** @brief Apply a function to each stored course in ascending order. */
+    void ForEach(const std::function<void(const Course&)>& fn) const;
+
+    /** @return Number of stored courses. */
+    size_t Size() const;
+
+    /** @brief Remove all keys and records. */
+    void Clear();
+
+private:
+    std::vector<uint64_t> heads;     // Eytzinger order, 1-based (slot 0 unused)
+    std::vector<uint32_t> ranks;     // Eytzinger slot -> sorted position
+    std::string keyText;             // folded keys, concatenated in sorted order
+    std::vector<uint32_t> keyOffsets; // start of each key in keyText, plus end
+    std::vector<Course> records;     // sorted order
+
+    /** Slots per prefetch: 8 heads fill a 64-byte line, i.e. three levels down. */
+    static constexpr size_t PREFETCH_STRIDE = 8;
+
+    /** @return Folded key at a sorted position. */
+    std::string_view KeyAt(size_t position) const;
+
+    /** Fill heads/ranks for the subtree at `slot` from sorted positions. */
+    void Layout(size_t slot, size_t& nextPosition);
+};
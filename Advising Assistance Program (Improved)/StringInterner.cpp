@@ -0,0 +1,64 @@
+#include "StringInterner.h"
+#include "Course.h"
+using namespace std;
+
+StringInterner::StringInterner() {
+    Clear();
+}
+
+// --- Interning ---
+uint32_t StringInterner::Intern(string_view s) {
+    // Keep the table at most half full so probe runs stay short
+    if ((Size() + 1) * 2 > slots.size()) Grow();
+
+    size_t mask = slots.size() - 1;
+    size_t slot = HashCourseKey(s) & mask;
+    while (slots[slot] != EMPTY_SLOT) {
+        if (CourseKeyEquals(Get(slots[slot]), s)) return slots[slot];
+        slot = (slot + 1) & mask;
+    }
+
+    uint32_t id = static_cast<uint32_t>(Size());
+    text.append(s.data(), s.size());
+    offsets.push_back(static_cast<uint32_t>(text.size()));
+    slots[slot] = id;
+    return id;
+}
+
+uint32_t StringInterner::Find(string_view s) const {
+    size_t mask = slots.size() - 1;
+    for (size_t slot = HashCourseKey(s) & mask; slots[slot] != EMPTY_SLOT; slot = (slot + 1) & mask) {
+        if (CourseKeyEquals(Get(slots[slot]), s)) return slots[slot];
+    }
+    return NOT_FOUND;
+}
+
+void StringInterner::Grow() {
+    vector<uint32_t> grown(slots.size() * 2, EMPTY_SLOT);
+    size_t mask = grown.size() - 1;
+    for (uint32_t id = 0; id < Size(); ++id) {
+        size_t slot = HashCourseKey(Get(id)) & mask;
+        while (grown[slot] != EMPTY_SLOT) slot = (slot + 1) & mask;
+        grown[slot] = id;
+    }
+    slots.swap(grown);
+}
+
+// --- Accessors ---
+string_view StringInterner::Get(uint32_t id) const {
+    return string_view(text.data() + offsets[id], offsets[id + 1] - offsets[id]);
+}
+
+size_t StringInterner::Size() const {
+    return offsets.size() - 1;
+}
+
+size_t StringInterner::MemoryBytes() const {
+    return text.capacity() + offsets.capacity() * sizeof(uint32_t) + slots.capacity() * sizeof(uint32_t);
+}
+
+void StringInterner::Clear() {
+    text.clear();
+    offsets.assign(1, 0);
+    slots.assign(16, EMPTY_SLOT);
+}
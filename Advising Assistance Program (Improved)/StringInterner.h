@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @file StringInterner.h
+ * @brief Maps course numbers (and other catalog keys) to dense 32-bit IDs.
+ *
+ * Each distinct string is stored once, back to back in one character arena,
+ * and gets the next ID (0, 1, 2, ...). Anything that refers to a course by
+ * number can then hold a 4-byte ID instead of its own std::string copy.
+ *
+ * Keys compare like course numbers: case-insensitively (see CourseKeyEquals),
+ * so "cs101" and "CS101" share one ID. The spelling stored for an ID is the
+ * first one interned.
+ */
+class StringInterner {
+public:
+    /** Returned by Find for a string that was never interned. */
+    static constexpr uint32_t NOT_FOUND = UINT32_MAX;
+
+    StringInterner();
+
+    /** @return ID of `s`, adding it if it is new. */
+    uint32_t Intern(std::string_view s);
+
+    /** @return ID of `s`, or NOT_FOUND. Never adds. */
+    uint32_t Find(std::string_view s) const;
+
+    /** @return The stored spelling of an ID (must be < Size()). */
+    std::string_view Get(uint32_t id) const;
+
+    /** @return Number of distinct strings. */
+    size_t Size() const;
+
+    /** @return Bytes held by the arena, offsets and hash slots (capacity). */
+    size_t MemoryBytes() const;
+
+    /** @brief Remove every string; IDs restart at 0. */
+    void Clear();
+
+private:
+    static constexpr uint32_t EMPTY_SLOT = UINT32_MAX;
+
+    std::string text;              // every string, back to back
+    std::vector<uint32_t> offsets; // start of each ID's string in text, plus end
+    std::vector<uint32_t> slots;   // open-addressed: ID or EMPTY_SLOT; power-of-two size
+
+    /** Double the slot table and reinsert every ID. */
+    void Grow();
+};